@@ -0,0 +1,118 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm;
+
+import android.support.test.runner.AndroidJUnit4;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+
+import io.realm.entities.Dog;
+import io.realm.internal.objectstore.OsColumnarExporter;
+import io.realm.rule.TestRealmConfigurationFactory;
+
+import static org.junit.Assert.assertEquals;
+
+@RunWith(AndroidJUnit4.class)
+public class OsColumnarExporterTests {
+    @Rule
+    public final TestRealmConfigurationFactory configFactory = new TestRealmConfigurationFactory();
+
+    private Realm realm;
+
+    @Before
+    public void setUp() {
+        realm = Realm.getInstance(configFactory.createConfiguration());
+        realm.beginTransaction();
+        addDog("a", 1, true);
+        addDog(null, 2, false);
+        addDog("ccc", 3, true);
+        realm.commitTransaction();
+    }
+
+    @After
+    public void tearDown() {
+        if (realm != null) {
+            realm.close();
+        }
+    }
+
+    private void addDog(String name, long age, boolean hasTail) {
+        Dog dog = realm.createObject(Dog.class);
+        dog.setName(name);
+        dog.setAge(age);
+        dog.setHasTail(hasTail);
+    }
+
+    @Test
+    public void writeTo() {
+        RealmResults<Dog> dogs = realm.where(Dog.class).sort(Dog.FIELD_AGE).findAll();
+        OsColumnarExporter exporter = new OsColumnarExporter(dogs.osResults,
+                new String[] {Dog.FIELD_NAME, Dog.FIELD_AGE, "hasTail"});
+        try {
+            assertEquals(3, exporter.getRowCount());
+            ByteBuffer buffer = ByteBuffer.allocateDirect((int) exporter.getRequiredSize())
+                    .order(ByteOrder.LITTLE_ENDIAN);
+            exporter.writeTo(buffer);
+            assertEquals(exporter.getRequiredSize(), buffer.position());
+
+            OsColumnarExporter.Column name = exporter.getColumn(0);
+            assertEquals(RealmFieldType.STRING, name.getFieldType());
+            assertEquals(1, name.getNullCount());
+            assertEquals(1, name.getValiditySize());
+            assertEquals(0b101, buffer.get((int) name.getValidityOffset()));
+            int offsets = (int) name.getValuesOffset();
+            assertEquals(0, buffer.getInt(offsets));
+            assertEquals(1, buffer.getInt(offsets + 4));
+            assertEquals(1, buffer.getInt(offsets + 8));
+            assertEquals(4, buffer.getInt(offsets + 12));
+            assertEquals(4, name.getDataSize());
+            byte[] data = new byte[4];
+            buffer.position((int) name.getDataOffset());
+            buffer.get(data);
+            assertEquals("accc", new String(data, Charset.forName("UTF-8")));
+
+            OsColumnarExporter.Column age = exporter.getColumn(1);
+            assertEquals(RealmFieldType.INTEGER, age.getFieldType());
+            assertEquals(0, age.getValiditySize());
+            assertEquals(0, age.getValuesOffset() % 64);
+            assertEquals(1, buffer.getLong((int) age.getValuesOffset()));
+            assertEquals(2, buffer.getLong((int) age.getValuesOffset() + 8));
+            assertEquals(3, buffer.getLong((int) age.getValuesOffset() + 16));
+
+            OsColumnarExporter.Column hasTail = exporter.getColumn(2);
+            assertEquals(RealmFieldType.BOOLEAN, hasTail.getFieldType());
+            assertEquals(0, hasTail.getValuesOffset() % 64);
+            assertEquals(0b101, buffer.get((int) hasTail.getValuesOffset()));
+        } finally {
+            exporter.close();
+        }
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void constructor_linkThrows() {
+        RealmResults<Dog> dogs = realm.where(Dog.class).findAll();
+        new OsColumnarExporter(dogs.osResults, new String[] {"owner"}).close();
+    }
+}
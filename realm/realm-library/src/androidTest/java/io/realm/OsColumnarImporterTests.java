@@ -0,0 +1,152 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm;
+
+import android.support.test.runner.AndroidJUnit4;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+
+import io.realm.entities.Dog;
+import io.realm.entities.PrimaryKeyAsLong;
+import io.realm.exceptions.RealmPrimaryKeyConstraintException;
+import io.realm.internal.objectstore.OsColumnarExporter;
+import io.realm.internal.objectstore.OsColumnarImporter;
+import io.realm.rule.TestRealmConfigurationFactory;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.fail;
+
+@RunWith(AndroidJUnit4.class)
+public class OsColumnarImporterTests {
+    @Rule
+    public final TestRealmConfigurationFactory configFactory = new TestRealmConfigurationFactory();
+
+    private Realm realm;
+
+    @Before
+    public void setUp() {
+        realm = Realm.getInstance(configFactory.createConfiguration());
+    }
+
+    @After
+    public void tearDown() {
+        if (realm != null) {
+            realm.close();
+        }
+    }
+
+    // ids {1, 2} and names {"new", "two"}.
+    private static OsColumnarImporter.Column[] writePrimaryKeyColumns(ByteBuffer buffer) {
+        buffer.putLong(0, 1).putLong(8, 2);
+        buffer.putInt(64, 0).putInt(68, 3).putInt(72, 6);
+        byte[] names = "newtwo".getBytes(Charset.forName("UTF-8"));
+        for (int i = 0; i < names.length; i++) {
+            buffer.put(128 + i, names[i]);
+        }
+        return new OsColumnarImporter.Column[] {
+                new OsColumnarImporter.Column(PrimaryKeyAsLong.FIELD_ID, 0, 0, 0, 16, 0, 0),
+                new OsColumnarImporter.Column(PrimaryKeyAsLong.FIELD_NAME, 0, 0, 64, 12, 128, 6)
+        };
+    }
+
+    @Test
+    public void importColumns_exportedColumns() {
+        realm.beginTransaction();
+        Dog dog = realm.createObject(Dog.class);
+        dog.setName("Fido");
+        dog.setAge(3);
+        realm.createObject(Dog.class).setAge(4);
+
+        RealmResults<Dog> dogs = realm.where(Dog.class).sort(Dog.FIELD_AGE).findAll();
+        OsColumnarExporter exporter = new OsColumnarExporter(dogs.osResults,
+                new String[] {Dog.FIELD_NAME, Dog.FIELD_AGE});
+        ByteBuffer buffer = ByteBuffer.allocateDirect((int) exporter.getRequiredSize());
+        exporter.writeTo(buffer);
+        buffer.rewind();
+        OsColumnarImporter.Column[] columns = {
+                OsColumnarImporter.Column.from(exporter.getColumn(0)),
+                OsColumnarImporter.Column.from(exporter.getColumn(1))
+        };
+        long created = OsColumnarImporter.importColumns(realm.getTable(Dog.class), buffer, exporter.getRowCount(),
+                columns, false);
+        exporter.close();
+        realm.commitTransaction();
+
+        assertEquals(2, created);
+        assertEquals(2, realm.where(Dog.class).equalTo(Dog.FIELD_NAME, "Fido").equalTo(Dog.FIELD_AGE, 3).count());
+        assertEquals(2, realm.where(Dog.class).isNull(Dog.FIELD_NAME).equalTo(Dog.FIELD_AGE, 4).count());
+    }
+
+    @Test
+    public void importColumns_updateExistingObjects() {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(192).order(ByteOrder.nativeOrder());
+        OsColumnarImporter.Column[] columns = writePrimaryKeyColumns(buffer);
+
+        realm.beginTransaction();
+        realm.createObject(PrimaryKeyAsLong.class, 1).setName("old");
+        long created = OsColumnarImporter.importColumns(realm.getTable(PrimaryKeyAsLong.class), buffer, 2, columns,
+                true);
+        realm.commitTransaction();
+
+        assertEquals(1, created);
+        assertEquals(2, realm.where(PrimaryKeyAsLong.class).count());
+        assertEquals("new", realm.where(PrimaryKeyAsLong.class).equalTo(PrimaryKeyAsLong.FIELD_ID, 1)
+                .findFirst().getName());
+        assertEquals("two", realm.where(PrimaryKeyAsLong.class).equalTo(PrimaryKeyAsLong.FIELD_ID, 2)
+                .findFirst().getName());
+    }
+
+    @Test(expected = RealmPrimaryKeyConstraintException.class)
+    public void importColumns_duplicatePrimaryKeyThrows() {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(192).order(ByteOrder.nativeOrder());
+        OsColumnarImporter.Column[] columns = writePrimaryKeyColumns(buffer);
+
+        realm.beginTransaction();
+        try {
+            realm.createObject(PrimaryKeyAsLong.class, 2);
+            OsColumnarImporter.importColumns(realm.getTable(PrimaryKeyAsLong.class), buffer, 2, columns, false);
+        } finally {
+            realm.cancelTransaction();
+        }
+    }
+
+    @Test
+    public void importColumns_primaryKeyConflictWritesNothing() {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(192).order(ByteOrder.nativeOrder());
+        OsColumnarImporter.Column[] columns = writePrimaryKeyColumns(buffer);
+        // ids {1, 1}
+        buffer.putLong(8, 1);
+
+        realm.beginTransaction();
+        try {
+            OsColumnarImporter.importColumns(realm.getTable(PrimaryKeyAsLong.class), buffer, 2, columns, false);
+            fail();
+        } catch (RealmPrimaryKeyConstraintException ignored) {
+            assertEquals(0, realm.where(PrimaryKeyAsLong.class).count());
+        } finally {
+            realm.cancelTransaction();
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm;
+
+import android.support.test.runner.AndroidJUnit4;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.Charset;
+import java.util.Date;
+
+import io.realm.entities.Dog;
+import io.realm.entities.Owner;
+import io.realm.internal.objectstore.OsJsonExporter;
+import io.realm.internal.objectstore.OsJsonImporter;
+import io.realm.rule.TestRealmConfigurationFactory;
+
+import static org.junit.Assert.assertEquals;
+
+@RunWith(AndroidJUnit4.class)
+public class OsJsonExporterTests {
+    private static final Charset UTF_8 = Charset.forName("UTF-8");
+
+    @Rule
+    public final TestRealmConfigurationFactory configFactory = new TestRealmConfigurationFactory();
+
+    private Realm realm;
+
+    @Before
+    public void setUp() {
+        realm = Realm.getInstance(configFactory.createConfiguration());
+        realm.beginTransaction();
+        Owner owner = realm.createObject(Owner.class);
+        owner.setName("Owner");
+        Dog dog = realm.createObject(Dog.class);
+        dog.setName("Fido \"æøå\"");
+        dog.setAge(3);
+        dog.setHeight(0.1f);
+        dog.setBirthday(new Date(1551675967089L));
+        dog.setOwner(owner);
+        realm.commitTransaction();
+    }
+
+    @After
+    public void tearDown() {
+        if (realm != null) {
+            realm.close();
+        }
+    }
+
+    // Reads through a small buffer to exercise the chunking.
+    private static String readAll(OsJsonExporter exporter) {
+        ByteBuffer chunk = ByteBuffer.allocateDirect(7);
+        ByteBuffer result = ByteBuffer.allocate(4096);
+        while (exporter.read(chunk) != -1) {
+            chunk.flip();
+            result.put(chunk);
+            chunk.clear();
+        }
+        return new String(result.array(), 0, result.position(), UTF_8);
+    }
+
+    @Test
+    public void read_projectionAndLinkDepth() {
+        RealmResults<Dog> dogs = realm.where(Dog.class).findAll();
+
+        OsJsonExporter exporter = new OsJsonExporter(dogs.osResults,
+                new String[] {Dog.FIELD_NAME, Dog.FIELD_HEIGHT, Dog.FIELD_BIRTHDAY, "owner"}, 1);
+        try {
+            assertEquals("[{\"name\":\"Fido \\\"æøå\\\"\",\"height\":0.1," +
+                    "\"birthday\":\"2019-03-04T05:06:07.089Z\",\"owner\":{\"name\":\"Owner\"}}]",
+                    readAll(exporter));
+        } finally {
+            exporter.close();
+        }
+
+        // Links beyond the depth are left out.
+        exporter = new OsJsonExporter(dogs.osResults, new String[] {Dog.FIELD_NAME, "owner"}, 0);
+        try {
+            assertEquals("[{\"name\":\"Fido \\\"æøå\\\"\"}]", readAll(exporter));
+        } finally {
+            exporter.close();
+        }
+    }
+
+    @Test
+    public void read_canBeImportedAgain() {
+        RealmResults<Dog> dogs = realm.where(Dog.class).findAll();
+        OsJsonExporter exporter = new OsJsonExporter(dogs.osResults, null, 0);
+        String json;
+        try {
+            json = readAll(exporter);
+        } finally {
+            exporter.close();
+        }
+
+        byte[] bytes = json.getBytes(UTF_8);
+        ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length);
+        buffer.put(bytes);
+        buffer.flip();
+        realm.beginTransaction();
+        OsJsonImporter.importFromBuffer(realm.getTable(Dog.class), buffer, false);
+        realm.commitTransaction();
+
+        RealmResults<Dog> imported = realm.where(Dog.class).isNull("owner").findAll();
+        assertEquals(1, imported.size());
+        Dog original = dogs.where().isNotNull("owner").findFirst();
+        assertEquals(original.getName(), imported.first().getName());
+        assertEquals(original.getAge(), imported.first().getAge());
+        assertEquals(original.getHeight(), imported.first().getHeight(), 0f);
+        assertEquals(original.getBirthday(), imported.first().getBirthday());
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm;
+
+import android.support.test.runner.AndroidJUnit4;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.io.ByteArrayInputStream;
+import java.nio.ByteBuffer;
+import java.nio.charset.Charset;
+import java.util.Date;
+
+import io.realm.entities.Dog;
+import io.realm.entities.PrimaryKeyAsLong;
+import io.realm.internal.objectstore.OsJsonImporter;
+import io.realm.rule.TestRealmConfigurationFactory;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+@RunWith(AndroidJUnit4.class)
+public class OsJsonImporterTests {
+    private static final Charset UTF_8 = Charset.forName("UTF-8");
+
+    @Rule
+    public final TestRealmConfigurationFactory configFactory = new TestRealmConfigurationFactory();
+
+    private Realm realm;
+
+    @Before
+    public void setUp() {
+        realm = Realm.getInstance(configFactory.createConfiguration());
+    }
+
+    @After
+    public void tearDown() {
+        if (realm != null) {
+            realm.close();
+        }
+    }
+
+    private static ByteBuffer toDirectBuffer(String json) {
+        byte[] bytes = json.getBytes(UTF_8);
+        ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length);
+        buffer.put(bytes);
+        buffer.flip();
+        return buffer;
+    }
+
+    @Test
+    public void importFromStream_allTypesAndLinks() {
+        String json = "[{\"name\": \"Fido \\u00e6\\u00f8\\u00e5\", \"age\": 3, \"height\": 1.5, \"weight\": 12.25, " +
+                "\"hasTail\": true, \"birthday\": \"2019-03-04T05:06:07.089Z\", \"owner\": {\"name\": \"Owner\"}, " +
+                "\"unknown\": {\"ignored\": [1, 2]}}, " +
+                "{\"name\": \"Rex\", \"birthday\": 1000}]";
+
+        realm.beginTransaction();
+        long count = OsJsonImporter.importFromStream(realm.getTable(Dog.class),
+                new ByteArrayInputStream(json.getBytes(UTF_8)), false);
+        realm.commitTransaction();
+
+        assertEquals(2, count);
+        Dog fido = realm.where(Dog.class).equalTo(Dog.FIELD_AGE, 3).findFirst();
+        assertEquals("Fido æøå", fido.getName());
+        assertEquals(1.5f, fido.getHeight(), 0f);
+        assertEquals(12.25d, fido.getWeight(), 0d);
+        assertTrue(fido.isHasTail());
+        assertEquals(new Date(1551675967089L), fido.getBirthday());
+        assertEquals("Owner", fido.getOwner().getName());
+
+        // Missing properties get the default values.
+        Dog rex = realm.where(Dog.class).equalTo(Dog.FIELD_NAME, "Rex").findFirst();
+        assertEquals(0, rex.getAge());
+        assertEquals(new Date(1000), rex.getBirthday());
+        assertNull(rex.getOwner());
+    }
+
+    @Test
+    public void importFromBuffer_updateKeepsMissingProperties() {
+        realm.beginTransaction();
+        realm.createObject(PrimaryKeyAsLong.class, 1).setName("old");
+        long count = OsJsonImporter.importFromBuffer(realm.getTable(PrimaryKeyAsLong.class),
+                toDirectBuffer("[{\"id\": 1}, {\"id\": 2, \"name\": \"new\"}]"), true);
+        realm.commitTransaction();
+
+        assertEquals(2, count);
+        assertEquals("old", realm.where(PrimaryKeyAsLong.class).equalTo(PrimaryKeyAsLong.FIELD_ID, 1).findFirst()
+                .getName());
+        assertEquals("new", realm.where(PrimaryKeyAsLong.class).equalTo(PrimaryKeyAsLong.FIELD_ID, 2).findFirst()
+                .getName());
+    }
+
+    @Test
+    public void importFromBuffer_malformedJsonThrows() {
+        String[] invalidJson = {
+                "{\"id\": 1}",
+                "[{\"id\": 1}",
+                "[{\"id\": \"1\"}]",
+                "[{\"id\": 1, \"name\": 2}]",
+                "[{\"id\": 1}] trailing"
+        };
+        realm.beginTransaction();
+        try {
+            for (String json : invalidJson) {
+                try {
+                    OsJsonImporter.importFromBuffer(realm.getTable(PrimaryKeyAsLong.class), toDirectBuffer(json),
+                            true);
+                    fail(json);
+                } catch (IllegalArgumentException ignored) {
+                }
+            }
+        } finally {
+            realm.cancelTransaction();
+        }
+    }
+}
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm;
+
+import android.support.test.runner.AndroidJUnit4;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.util.Collections;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicReference;
+
+import io.realm.entities.PrimaryKeyAsLong;
+import io.realm.internal.Table;
+import io.realm.internal.objectstore.OsImportPipeline;
+import io.realm.internal.objectstore.OsObjectBuilder;
+import io.realm.rule.TestRealmConfigurationFactory;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+@RunWith(AndroidJUnit4.class)
+public class OsObjectBuilderTests {
+    @Rule
+    public final TestRealmConfigurationFactory configFactory = new TestRealmConfigurationFactory();
+
+    private Realm realm;
+    private Table table;
+    private long idColumn;
+    private long nameColumn;
+
+    @Before
+    public void setUp() {
+        realm = Realm.getInstance(configFactory.createConfiguration());
+        table = realm.getTable(PrimaryKeyAsLong.class);
+        idColumn = table.getColumnIndex(PrimaryKeyAsLong.FIELD_ID);
+        nameColumn = table.getColumnIndex(PrimaryKeyAsLong.FIELD_NAME);
+    }
+
+    @After
+    public void tearDown() {
+        if (realm != null) {
+            realm.close();
+        }
+    }
+
+    private OsObjectBuilder newBuilder() {
+        //noinspection unchecked
+        return new OsObjectBuilder(table, table.getColumnCount() - 1, Collections.EMPTY_SET);
+    }
+
+    @Test
+    public void createOrUpdateObjects_create() {
+        realm.beginTransaction();
+        OsObjectBuilder builder = newBuilder();
+        for (int i = 0; i < 100; i++) {
+            if (i > 0) {
+                builder.nextObject();
+            }
+            builder.addInteger(idColumn, (long) i);
+            builder.addString(nameColumn, "name_" + i);
+        }
+        long[] rowIndices = builder.createOrUpdateObjects(false);
+        realm.commitTransaction();
+
+        assertEquals(100, rowIndices.length);
+        assertEquals(100, realm.where(PrimaryKeyAsLong.class).count());
+        for (int i = 0; i < rowIndices.length; i++) {
+            assertEquals(i, table.getLong(idColumn, rowIndices[i]));
+            assertEquals("name_" + i, table.getString(nameColumn, rowIndices[i]));
+        }
+    }
+
+    @Test
+    public void createOrUpdateObjects_update() {
+        realm.beginTransaction();
+        PrimaryKeyAsLong existing = realm.createObject(PrimaryKeyAsLong.class, 1);
+        existing.setName("old");
+
+        OsObjectBuilder builder = newBuilder();
+        builder.addInteger(idColumn, 2L);
+        builder.addString(nameColumn, "new_2");
+        builder.nextObject();
+        // Columns which are not set must not keep the value of the previous object.
+        builder.addInteger(idColumn, 1L);
+        long[] rowIndices = builder.createOrUpdateObjects(true);
+        realm.commitTransaction();
+
+        assertEquals(2, rowIndices.length);
+        assertEquals(2, realm.where(PrimaryKeyAsLong.class).count());
+        assertEquals("new_2", table.getString(nameColumn, rowIndices[0]));
+        assertEquals(1, table.getLong(idColumn, rowIndices[1]));
+        assertNull(realm.where(PrimaryKeyAsLong.class).equalTo(PrimaryKeyAsLong.FIELD_ID, 1).findFirst().getName());
+    }
+
+    @Test
+    public void createOrUpdateObjects_afterClassRemoved() {
+        DynamicRealm dynamicRealm = DynamicRealm.getInstance(configFactory.createConfiguration("dynamic"));
+        try {
+            RealmSchema schema = dynamicRealm.getSchema();
+            dynamicRealm.beginTransaction();
+            schema.create("First").addField("value", long.class);
+            schema.create("Second").addField("name", String.class);
+            dynamicRealm.commitTransaction();
+
+            dynamicRealm.beginTransaction();
+            Table firstTable = schema.getTable("First");
+            //noinspection unchecked
+            OsObjectBuilder builder = new OsObjectBuilder(firstTable, firstTable.getColumnCount() - 1,
+                    Collections.EMPTY_SET);
+            builder.addInteger(firstTable.getColumnIndex("value"), 42L);
+            builder.createNewObject();
+            dynamicRealm.commitTransaction();
+
+            // Removing a table moves the last one into its place, the class cached for the index of "First" must
+            // not be used for "Second".
+            dynamicRealm.beginTransaction();
+            schema.remove("First");
+            dynamicRealm.commitTransaction();
+
+            dynamicRealm.beginTransaction();
+            Table secondTable = schema.getTable("Second");
+            //noinspection unchecked
+            builder = new OsObjectBuilder(secondTable, secondTable.getColumnCount() - 1, Collections.EMPTY_SET);
+            builder.addString(secondTable.getColumnIndex("name"), "second");
+            builder.createNewObject();
+            dynamicRealm.commitTransaction();
+
+            assertEquals(1, dynamicRealm.where("Second").count());
+            assertEquals("second", dynamicRealm.where("Second").findFirst().getString("name"));
+        } finally {
+            dynamicRealm.close();
+        }
+    }
+
+    @Test
+    public void importPipeline_writesBatchesPreparedOnOtherThread() throws Throwable {
+        //noinspection unchecked
+        final OsImportPipeline pipeline = new OsImportPipeline(table, table.getColumnCount() - 1,
+                Collections.EMPTY_SET, 2);
+        final AtomicReference<Throwable> producerError = new AtomicReference<Throwable>();
+        Thread producer = new Thread(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    for (int batch = 0; batch < 4; batch++) {
+                        OsObjectBuilder builder = pipeline.newBuilder();
+                        for (int i = 0; i < 25; i++) {
+                            if (i > 0) {
+                                builder.nextObject();
+                            }
+                            builder.addInteger(idColumn, (long) (batch * 25 + i));
+                            builder.addString(nameColumn, "name_" + (batch * 25 + i));
+                        }
+                        pipeline.submit(builder);
+                    }
+                } catch (Throwable e) {
+                    producerError.set(e);
+                }
+            }
+        });
+        producer.start();
+
+        realm.beginTransaction();
+        long[][] rowIndices = new long[4][];
+        for (int batch = 0; batch < 4; batch++) {
+            rowIndices[batch] = pipeline.writeNextBatch(false);
+        }
+        realm.commitTransaction();
+        producer.join();
+        pipeline.close();
+
+        if (producerError.get() != null) {
+            throw producerError.get();
+        }
+        assertEquals(100, realm.where(PrimaryKeyAsLong.class).count());
+        for (int batch = 0; batch < 4; batch++) {
+            assertEquals(25, rowIndices[batch].length);
+            for (int i = 0; i < 25; i++) {
+                assertEquals(batch * 25 + i, table.getLong(idColumn, rowIndices[batch][i]));
+                assertEquals("name_" + (batch * 25 + i), table.getString(nameColumn, rowIndices[batch][i]));
+            }
+        }
+    }
+
+    @Test
+    public void importPipeline_submitValidatesAgainstSchema() throws InterruptedException {
+        //noinspection unchecked
+        OsImportPipeline pipeline = new OsImportPipeline(table, table.getColumnCount() - 1, Collections.EMPTY_SET, 2);
+        try {
+            OsObjectBuilder builder = pipeline.newBuilder();
+            builder.addString(idColumn, "not a number");
+            try {
+                pipeline.submit(builder);
+                fail();
+            } catch (IllegalArgumentException ignored) {
+            }
+
+            realm.beginTransaction();
+            assertEquals(0, pipeline.writeReadyBatches(false).length);
+            realm.commitTransaction();
+        } finally {
+            pipeline.close();
+        }
+    }
+
+    @Test
+    public void importPipeline_closeWaitsForBlockedProducer() throws Throwable {
+        //noinspection unchecked
+        final OsImportPipeline pipeline = new OsImportPipeline(table, table.getColumnCount() - 1,
+                Collections.EMPTY_SET, 1);
+        final CountDownLatch firstSubmitted = new CountDownLatch(1);
+        final AtomicReference<Throwable> producerError = new AtomicReference<Throwable>();
+        Thread producer = new Thread(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    // The second batch blocks on the full queue until close() drains it, the third one is rejected.
+                    for (int batch = 0; batch < 3; batch++) {
+                        OsObjectBuilder builder = pipeline.newBuilder();
+                        builder.addInteger(idColumn, (long) batch);
+                        pipeline.submit(builder);
+                        firstSubmitted.countDown();
+                    }
+                } catch (Throwable e) {
+                    producerError.set(e);
+                }
+            }
+        });
+        producer.start();
+        TestHelper.awaitOrFail(firstSubmitted);
+
+        pipeline.close();
+        producer.join();
+
+        assertTrue(producerError.get() instanceof IllegalStateException);
+    }
+}
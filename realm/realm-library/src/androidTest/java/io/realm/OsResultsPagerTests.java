@@ -0,0 +1,195 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm;
+
+import android.support.test.runner.AndroidJUnit4;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import javax.annotation.Nullable;
+
+import io.realm.entities.Dog;
+import io.realm.internal.OsResultsPager;
+import io.realm.internal.Table;
+import io.realm.internal.core.QueryDescriptor;
+import io.realm.rule.TestRealmConfigurationFactory;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.fail;
+
+@RunWith(AndroidJUnit4.class)
+public class OsResultsPagerTests {
+    private static final int TEST_SIZE = 25;
+
+    @Rule
+    public final TestRealmConfigurationFactory configFactory = new TestRealmConfigurationFactory();
+
+    private Realm realm;
+    private Table table;
+
+    @Before
+    public void setUp() {
+        realm = Realm.getInstance(configFactory.createConfiguration());
+        realm.beginTransaction();
+        // Ages in a different order than the rows, with duplicates.
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Dog dog = realm.createObject(Dog.class);
+            dog.setName("Dog " + i);
+            dog.setAge((i * 7) % 10);
+        }
+        realm.commitTransaction();
+        table = realm.getTable(Dog.class);
+    }
+
+    @After
+    public void tearDown() {
+        if (realm != null) {
+            realm.close();
+        }
+    }
+
+    private QueryDescriptor sortByAge() {
+        return QueryDescriptor.getTestInstance(table, new long[] {table.getColumnIndex(Dog.FIELD_AGE)});
+    }
+
+    private void assertPage(RealmResults<Dog> expected, int from, int pageSize, long[] page) {
+        assertEquals(Math.min(pageSize, expected.size() - from), page.length);
+        for (int i = 0; i < page.length; i++) {
+            assertEquals(expected.get(from + i).getName(), table.getUncheckedRow(page[i]).getString(
+                    table.getColumnIndex(Dog.FIELD_NAME)));
+        }
+    }
+
+    @Test
+    public void nextPage_sorted() {
+        RealmResults<Dog> all = realm.where(Dog.class).findAll();
+        RealmResults<Dog> sorted = all.sort(Dog.FIELD_AGE);
+        OsResultsPager pager = all.osResults.createPager(sortByAge(), 0, 10);
+
+        assertPage(sorted, 0, 10, pager.nextPage());
+        assertPage(sorted, 10, 10, pager.nextPage());
+        long[] last = pager.nextPage();
+        assertEquals(5, last.length);
+        assertPage(sorted, 20, 10, last);
+        assertEquals(0, pager.nextPage().length);
+    }
+
+    @Test
+    public void nextPage_sortedWithOffset() {
+        RealmResults<Dog> matches = realm.where(Dog.class).greaterThan(Dog.FIELD_AGE, 2).findAll();
+        RealmResults<Dog> sorted = matches.sort(Dog.FIELD_AGE, Sort.ASCENDING);
+        OsResultsPager pager = matches.osResults.createPager(sortByAge(), 3, 4);
+
+        assertPage(sorted, 3, 4, pager.nextPage());
+        assertPage(sorted, 7, 4, pager.nextPage());
+    }
+
+    @Test
+    public void nextPage_unsorted() {
+        RealmResults<Dog> all = realm.where(Dog.class).findAll();
+        OsResultsPager pager = all.osResults.createPager(null, 5, 10);
+
+        assertPage(all, 5, 10, pager.nextPage());
+        assertPage(all, 15, 10, pager.nextPage());
+        assertEquals(0, pager.nextPage().length);
+    }
+
+    private List<String> names(List<Dog> dogs) {
+        List<String> names = new ArrayList<String>();
+        for (Dog dog : dogs) {
+            names.add(dog.getName());
+        }
+        return names;
+    }
+
+    private void nextPage_returnsMatchesOfFirstPage(@Nullable QueryDescriptor sortDescriptor,
+            List<Dog> expectedOrder) {
+        RealmResults<Dog> all = realm.where(Dog.class).findAll();
+        List<String> expected = names(expectedOrder);
+        OsResultsPager pager = all.osResults.createPager(sortDescriptor, 0, 10);
+        long nameColumn = table.getColumnIndex(Dog.FIELD_NAME);
+        List<String> returned = new ArrayList<String>();
+        for (long row : pager.nextPage()) {
+            returned.add(table.getUncheckedRow(row).getString(nameColumn));
+        }
+
+        // Deleting a row moves the last row into its place. The moved row is still returned once, the deleted row
+        // and the row added after the first page are not returned.
+        realm.beginTransaction();
+        Dog deleted = expectedOrder.get(15);
+        expected.remove(deleted.getName());
+        deleted.deleteFromRealm();
+        Dog added = realm.createObject(Dog.class);
+        added.setName("Added");
+        added.setAge(-1);
+        realm.commitTransaction();
+
+        long[] page;
+        while ((page = pager.nextPage()).length > 0) {
+            for (long row : page) {
+                returned.add(table.getUncheckedRow(row).getString(nameColumn));
+            }
+        }
+        assertEquals(expected, returned);
+    }
+
+    @Test
+    public void nextPage_sorted_returnsMatchesOfFirstPage() {
+        RealmResults<Dog> sorted = realm.where(Dog.class).sort(Dog.FIELD_AGE).findAll();
+        nextPage_returnsMatchesOfFirstPage(sortByAge(), sorted.createSnapshot());
+    }
+
+    @Test
+    public void nextPage_unsorted_returnsMatchesOfFirstPage() {
+        RealmResults<Dog> all = realm.where(Dog.class).findAll();
+        nextPage_returnsMatchesOfFirstPage(null, all.createSnapshot());
+    }
+
+    @Test
+    public void createPager_invalidArgumentsThrows() {
+        RealmResults<Dog> all = realm.where(Dog.class).findAll();
+        try {
+            all.osResults.createPager(null, 0, 0);
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        try {
+            all.osResults.createPager(null, -1, 10);
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        try {
+            QueryDescriptor byOwnerName = QueryDescriptor.getTestInstance(table,
+                    new long[] {table.getColumnIndex("owner"), 0});
+            all.osResults.createPager(byOwnerName, 0, 10);
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        try {
+            realm.where(Dog.class).limit(5).findAll().osResults.createPager(null, 0, 10);
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+    }
+}
@@ -26,6 +26,7 @@ import org.junit.Test;
 import org.junit.rules.ExpectedException;
 import org.junit.runner.RunWith;
 
+import java.util.ArrayList;
 import java.util.Collections;
 import java.util.List;
 import java.util.concurrent.CountDownLatch;
@@ -38,11 +39,15 @@ import io.realm.entities.CyclicType;
 import io.realm.entities.CyclicTypePrimaryKey;
 import io.realm.entities.Dog;
 import io.realm.entities.Owner;
+import io.realm.internal.OsList;
 import io.realm.internal.RealmObjectProxy;
+import io.realm.internal.Table;
+import io.realm.internal.core.QueryDescriptor;
 import io.realm.rule.RunInLooperThread;
 import io.realm.rule.RunTestInLooperThread;
 import io.realm.rule.TestRealmConfigurationFactory;
 
+import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertNotNull;
@@ -1148,4 +1153,134 @@ public class RealmListTests extends CollectionTests {
     public void getRealm_returnsNullForUnmanagedList() {
         assertNull(new RealmList().getRealm());
     }
+
+    @Test
+    public void osList_applyPermutation() {
+        int[] newOrder = new int[TEST_SIZE];
+        for (int i = 0; i < TEST_SIZE; i++) {
+            newOrder[i] = (i * 3) % TEST_SIZE;
+        }
+        realm.beginTransaction();
+        collection.getOsList().applyPermutation(newOrder);
+        realm.commitTransaction();
+
+        assertEquals(TEST_SIZE, collection.size());
+        for (int i = 0; i < TEST_SIZE; i++) {
+            assertEquals("Dog " + newOrder[i], collection.get(i).getName());
+        }
+    }
+
+    @Test
+    public void osList_applyPermutation_invalidOrderThrows() {
+        realm.beginTransaction();
+        try {
+            collection.getOsList().applyPermutation(new int[] {0, 1});
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        int[] newOrder = new int[TEST_SIZE];
+        try {
+            // All zeros.
+            collection.getOsList().applyPermutation(newOrder);
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        realm.cancelTransaction();
+    }
+
+    @Test
+    public void osList_addAllRows_setRangeRows() {
+        long dogCount = realm.getTable(Dog.class).size();
+        OsList osList = collection.getOsList();
+        realm.beginTransaction();
+        osList.addAllRows(new long[] {1, 0});
+        osList.setRangeRows(0, new long[] {2});
+        realm.commitTransaction();
+
+        assertEquals(TEST_SIZE + 2, collection.size());
+        assertEquals("Dog 2", collection.get(0).getName());
+        assertEquals("Dog 1", collection.get(TEST_SIZE).getName());
+        assertEquals("Dog 0", collection.get(TEST_SIZE + 1).getName());
+
+        // All indices are checked before anything is written.
+        realm.beginTransaction();
+        try {
+            osList.addAllRows(new long[] {0, dogCount});
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        assertEquals(TEST_SIZE + 2, collection.size());
+        try {
+            osList.setRangeRows(0, new long[] {3, -1});
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        assertEquals("Dog 2", collection.get(0).getName());
+        assertEquals("Dog 1", collection.get(1).getName());
+        realm.cancelTransaction();
+    }
+
+    @Test
+    public void osList_keyPathFilter() {
+        final List<int[]> insertions = new ArrayList<int[]>();
+        final List<int[]> changes = new ArrayList<int[]>();
+        OsList osList = collection.getOsList();
+        osList.setKeyPathFilter(new String[] {Dog.FIELD_AGE});
+        osList.addListener(collection, new OrderedRealmCollectionChangeListener<RealmList<Dog>>() {
+            @Override
+            public void onChange(RealmList<Dog> dogs, OrderedCollectionChangeSet changeSet) {
+                insertions.add(changeSet.getInsertions());
+                changes.add(changeSet.getChanges());
+            }
+        });
+
+        // The insertion is delivered without the modification of the name.
+        realm.beginTransaction();
+        collection.get(0).setName("Renamed");
+        collection.add(0, realm.createObject(Dog.class));
+        realm.commitTransaction();
+        realm.refresh();
+        assertEquals(1, insertions.size());
+        assertArrayEquals(new int[] {0}, insertions.get(0));
+        assertEquals(0, changes.get(0).length);
+
+        // Only the name changes.
+        realm.beginTransaction();
+        collection.get(1).setName("Renamed again");
+        realm.commitTransaction();
+        realm.refresh();
+        assertEquals(1, changes.size());
+
+        // Dog 1 is at 2 after the insertion.
+        realm.beginTransaction();
+        collection.get(2).setName("Renamed");
+        collection.get(2).setAge(42);
+        realm.commitTransaction();
+        realm.refresh();
+        assertEquals(2, changes.size());
+        assertArrayEquals(new int[] {2}, changes.get(1));
+        assertEquals(0, insertions.get(1).length);
+        osList.removeAllListeners();
+    }
+
+    @Test
+    public void osList_sortBy() {
+        realm.beginTransaction();
+        for (int i = 0; i < TEST_SIZE; i++) {
+            collection.get(i).setAge(TEST_SIZE - i);
+        }
+        // The same object twice keeps its relative order.
+        collection.add(collection.get(0));
+        Table table = realm.getTable(Dog.class);
+        QueryDescriptor sortDescriptor =
+                QueryDescriptor.getTestInstance(table, new long[] {table.getColumnIndex(Dog.FIELD_AGE)});
+        collection.getOsList().sortBy(sortDescriptor);
+        realm.commitTransaction();
+
+        assertEquals(TEST_SIZE + 1, collection.size());
+        for (int i = 0; i < TEST_SIZE; i++) {
+            assertEquals(i + 1, collection.get(i).getAge());
+        }
+        assertEquals("Dog 0", collection.get(TEST_SIZE).getName());
+    }
 }
@@ -52,6 +52,8 @@ import io.realm.entities.PrimaryKeyAsString;
 import io.realm.entities.RandomPrimaryKey;
 import io.realm.entities.StringOnly;
 import io.realm.internal.OsResults;
+import io.realm.internal.Table;
+import io.realm.internal.objectstore.OsObjectBuilder;
 import io.realm.log.RealmLog;
 import io.realm.rule.RunInLooperThread;
 import io.realm.rule.RunTestInLooperThread;
@@ -1400,6 +1402,72 @@ public class RealmResultsTests extends CollectionTests {
         }
     }
 
+    @Test
+    public void setMany() {
+        realm.beginTransaction();
+        for (int i = 0; i < 5; i++) {
+            Dog dog = realm.createObject(Dog.class);
+            dog.setName("Dog " + i);
+            dog.setAge(i);
+        }
+        // Setting the age would remove the objects from the results if they were not updated from a snapshot.
+        RealmResults<Dog> dogs = realm.where(Dog.class).lessThan(Dog.FIELD_AGE, 3).findAll();
+        Table table = realm.getTable(Dog.class);
+        long nameIndex = table.getColumnIndex(Dog.FIELD_NAME);
+        long ageIndex = table.getColumnIndex(Dog.FIELD_AGE);
+        long hasTailIndex = table.getColumnIndex(Dog.FIELD_HAS_TAIL);
+        OsObjectBuilder values = new OsObjectBuilder(table, table.getColumnCount(), Collections.<ImportFlag>emptySet());
+        values.addString(nameIndex, "Updated");
+        values.addInteger(ageIndex, 42L);
+        values.addBoolean(hasTailIndex, true);
+        dogs.osResults.setMany(new long[] {nameIndex, ageIndex, hasTailIndex}, values);
+        realm.commitTransaction();
+
+        assertEquals(0, dogs.size());
+        RealmResults<Dog> updated = realm.where(Dog.class).equalTo(Dog.FIELD_NAME, "Updated").findAll();
+        assertEquals(3, updated.size());
+        for (Dog dog : updated) {
+            assertEquals(42, dog.getAge());
+            assertTrue(dog.isHasTail());
+        }
+        assertEquals(2, realm.where(Dog.class).lessThan(Dog.FIELD_AGE, 42).count());
+    }
+
+    @Test
+    public void setMany_invalidValueThrows() {
+        realm.beginTransaction();
+        realm.createObject(Dog.class).setName("Dog");
+        Table table = realm.getTable(Dog.class);
+        long nameIndex = table.getColumnIndex(Dog.FIELD_NAME);
+        long ageIndex = table.getColumnIndex(Dog.FIELD_AGE);
+        OsObjectBuilder values = new OsObjectBuilder(table, table.getColumnCount(), Collections.<ImportFlag>emptySet());
+        values.addString(nameIndex, "Updated");
+        values.addString(ageIndex, "Not a number");
+        try {
+            realm.where(Dog.class).findAll().osResults.setMany(new long[] {nameIndex, ageIndex}, values);
+            fail();
+        } catch (IllegalArgumentException ignore) {
+        }
+        // Nothing is written if one of the values is invalid.
+        assertEquals("Dog", realm.where(Dog.class).findFirst().getName());
+        realm.cancelTransaction();
+    }
+
+    @Test
+    public void setMany_primaryKeyFieldThrows() {
+        realm.beginTransaction();
+        Table table = realm.getTable(PrimaryKeyAsLong.class);
+        long idIndex = table.getColumnIndex(PrimaryKeyAsLong.FIELD_ID);
+        OsObjectBuilder values = new OsObjectBuilder(table, table.getColumnCount(), Collections.<ImportFlag>emptySet());
+        values.addInteger(idIndex, 42L);
+        try {
+            realm.where(PrimaryKeyAsLong.class).findAll().osResults.setMany(new long[] {idIndex}, values);
+            fail();
+        } catch (IllegalStateException ignore) {
+        }
+        realm.cancelTransaction();
+    }
+
     @Test
     public void setValue_specificType_modelClassNameOnTypedRealms() {
         populateMappedAllJavaTypes(5);
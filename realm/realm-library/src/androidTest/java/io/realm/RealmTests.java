@@ -1356,6 +1356,39 @@ public class RealmTests {
         assertEquals(new Date(1), realmTypes.getColumnDateList().get(0));
     }
 
+    // The object values are serialized into a buffer which has to grow for big values.
+    @Test
+    public void copyToRealm_bigAndNonAsciiValues() {
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < 10000; i++) {
+            sb.append("a\u00e6\u5ea6\ud83d\ude00");
+        }
+        String bigString = sb.toString();
+        byte[] bigBinary = new byte[200 * 1024];
+        new Random(42).nextBytes(bigBinary);
+
+        AllTypes allTypes = new AllTypes();
+        allTypes.setColumnString(bigString);
+        allTypes.setColumnBinary(bigBinary);
+        allTypes.setColumnStringList(new RealmList<String>("\ud83d\ude00", null, bigString));
+        allTypes.setColumnBinaryList(new RealmList<byte[]>(bigBinary, null, new byte[0]));
+
+        realm.beginTransaction();
+        AllTypes realmTypes = realm.copyToRealm(allTypes);
+        realm.commitTransaction();
+
+        assertEquals(bigString, realmTypes.getColumnString());
+        assertArrayEquals(bigBinary, realmTypes.getColumnBinary());
+        assertEquals(3, realmTypes.getColumnStringList().size());
+        assertEquals("\ud83d\ude00", realmTypes.getColumnStringList().get(0));
+        assertNull(realmTypes.getColumnStringList().get(1));
+        assertEquals(bigString, realmTypes.getColumnStringList().get(2));
+        assertEquals(3, realmTypes.getColumnBinaryList().size());
+        assertArrayEquals(bigBinary, realmTypes.getColumnBinaryList().get(0));
+        assertNull(realmTypes.getColumnBinaryList().get(1));
+        assertArrayEquals(new byte[0], realmTypes.getColumnBinaryList().get(2));
+    }
+
     @Test
     public void copyToRealm_cyclicObjectReferences() {
         CyclicType oneCyclicType = new CyclicType();
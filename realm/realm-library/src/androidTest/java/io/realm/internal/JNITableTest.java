@@ -50,7 +50,6 @@ public class JNITableTest {
     @Rule
     public final TestRealmConfigurationFactory configFactory = new TestRealmConfigurationFactory();
 
-    @SuppressWarnings("FieldCanBeLocal")
     private RealmConfiguration config;
     private OsSharedRealm sharedRealm;
 
@@ -287,6 +286,86 @@ public class JNITableTest {
         } catch (IllegalArgumentException ignored) { }
     }
 
+    @Test
+    public void getColumnIndex_repeatedLookup() {
+        final StringBuilder longName = new StringBuilder();
+        for (int i = 0; i < 100; i++) {
+            longName.append('x');
+        }
+        Table t = TestHelper.createTable(sharedRealm, "temp", new TestHelper.AdditionalTableSetup() {
+            @Override
+            public void execute(Table t) {
+                t.addColumn(RealmFieldType.INTEGER, "int");
+                t.addColumn(RealmFieldType.STRING, "\u00e6\u00f8\u00e5");
+                t.addColumn(RealmFieldType.STRING, longName.toString());
+            }
+        });
+
+        // The second round is served from the cache.
+        for (int i = 0; i < 2; i++) {
+            assertEquals(0, t.getColumnIndex("int"));
+            assertEquals(1, t.getColumnIndex("\u00e6\u00f8\u00e5"));
+            assertEquals(2, t.getColumnIndex(longName.toString()));
+            assertEquals(-1, t.getColumnIndex("non-existing column"));
+        }
+    }
+
+    @Test
+    public void getColumnIndex_afterSchemaChange() {
+        Table t = TestHelper.createTable(sharedRealm, "temp", new TestHelper.AdditionalTableSetup() {
+            @Override
+            public void execute(Table t) {
+                t.addColumn(RealmFieldType.INTEGER, "a");
+                t.addColumn(RealmFieldType.INTEGER, "b");
+            }
+        });
+        assertEquals(0, t.getColumnIndex("a"));
+        assertEquals(1, t.getColumnIndex("b"));
+
+        sharedRealm.beginTransaction();
+        t.insertColumn(0, RealmFieldType.STRING, "c");
+        sharedRealm.commitTransaction();
+        assertEquals(1, t.getColumnIndex("a"));
+        assertEquals(2, t.getColumnIndex("b"));
+
+        sharedRealm.beginTransaction();
+        t.removeColumn(1);
+        t.renameColumn(1, "d");
+        sharedRealm.commitTransaction();
+        assertEquals(-1, t.getColumnIndex("a"));
+        assertEquals(-1, t.getColumnIndex("b"));
+        assertEquals(0, t.getColumnIndex("c"));
+        assertEquals(1, t.getColumnIndex("d"));
+    }
+
+    @Test
+    public void getColumnIndex_otherTableAfterReopen() {
+        TestHelper.createTable(sharedRealm, "first", new TestHelper.AdditionalTableSetup() {
+            @Override
+            public void execute(Table t) {
+                t.addColumn(RealmFieldType.INTEGER, "a");
+                t.addColumn(RealmFieldType.INTEGER, "b");
+            }
+        });
+        TestHelper.createTable(sharedRealm, "second", new TestHelper.AdditionalTableSetup() {
+            @Override
+            public void execute(Table t) {
+                t.addColumn(RealmFieldType.INTEGER, "b");
+                t.addColumn(RealmFieldType.INTEGER, "a");
+            }
+        });
+        Table first = sharedRealm.getTable("first");
+        assertEquals(0, first.getColumnIndex("a"));
+        assertEquals(1, first.getColumnIndex("b"));
+
+        // The new table accessor might be allocated where the one of "first" was.
+        sharedRealm.close();
+        sharedRealm = OsSharedRealm.getInstance(config);
+        Table second = sharedRealm.getTable("second");
+        assertEquals(1, second.getColumnIndex("a"));
+        assertEquals(0, second.getColumnIndex("b"));
+    }
+
     @Test
     public void setNulls() {
         Table t = TestHelper.createTable(sharedRealm, "temp", new TestHelper.AdditionalTableSetup() {
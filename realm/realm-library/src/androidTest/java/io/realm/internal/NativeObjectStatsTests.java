@@ -0,0 +1,84 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal;
+
+import android.support.test.runner.AndroidJUnit4;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import io.realm.RealmConfiguration;
+import io.realm.RealmFieldType;
+import io.realm.internal.core.DescriptorOrdering;
+import io.realm.rule.TestRealmConfigurationFactory;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+@RunWith(AndroidJUnit4.class)
+public class NativeObjectStatsTests {
+    @Rule
+    public final TestRealmConfigurationFactory configFactory = new TestRealmConfigurationFactory();
+
+    private OsSharedRealm sharedRealm;
+    private Table table;
+
+    @Before
+    public void setUp() {
+        RealmConfiguration config = configFactory.createConfiguration();
+        sharedRealm = OsSharedRealm.getInstance(config);
+        sharedRealm.beginTransaction();
+        table = sharedRealm.createTable(Table.getTableNameForClass("test_table"));
+        table.addColumn(RealmFieldType.INTEGER, "age");
+        OsObject.createRow(table);
+        sharedRealm.commitTransaction();
+    }
+
+    @After
+    public void tearDown() {
+        sharedRealm.close();
+    }
+
+    @Test
+    public void snapshot_countsCreatedObjects() {
+        NativeObjectStats before = NativeObjectStats.snapshot();
+
+        // Keep strong references so the finalizer daemon cannot free them during the test.
+        DescriptorOrdering ordering = new DescriptorOrdering();
+        OsResults results = OsResults.createFromQuery(sharedRealm, table.where(), ordering);
+        UncheckedRow row = results.getUncheckedRow(0);
+
+        NativeObjectStats after = NativeObjectStats.snapshot();
+        assertTrue(after.getLiveCount(NativeObjectStats.TYPE_RESULTS)
+                >= before.getLiveCount(NativeObjectStats.TYPE_RESULTS) + 1);
+        assertTrue(after.getLiveCount(NativeObjectStats.TYPE_DESCRIPTOR_ORDERING)
+                >= before.getLiveCount(NativeObjectStats.TYPE_DESCRIPTOR_ORDERING) + 1);
+        assertTrue(after.getLiveCount(NativeObjectStats.TYPE_ROW)
+                >= before.getLiveCount(NativeObjectStats.TYPE_ROW) + 1);
+        assertTrue(after.getLiveBytes(NativeObjectStats.TYPE_ROW) > 0);
+        assertTrue(after.getTotalLiveBytes() > 0);
+        assertEquals(0, row.getLong(0));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void getLiveCount_invalidTypeThrows() {
+        NativeObjectStats.snapshot().getLiveCount(NativeObjectStats.NUM_TYPES);
+    }
+}
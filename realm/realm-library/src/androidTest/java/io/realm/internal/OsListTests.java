@@ -481,4 +481,278 @@ public class OsListTests {
         } catch (IllegalArgumentException ignored) {
         }
     }
+
+    @Test
+    public void addAll_setRange_Long() {
+        long index = testObjectSchemaInfo.getProperty("longList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        osList.addAllLongs(new long[] {1, 2, 3}, null);
+        osList.addAllLongs(new long[] {4, 0}, new boolean[] {false, true});
+        assertEquals(5, osList.size());
+        assertEquals(3L, osList.getValue(2));
+        assertEquals(4L, osList.getValue(3));
+        assertNull(osList.getValue(4));
+
+        osList.setRangeLongs(3, new long[] {0, 5}, new boolean[] {true, false});
+        assertNull(osList.getValue(3));
+        assertEquals(5L, osList.getValue(4));
+    }
+
+    @Test
+    public void addAll_setRange_required_Long() {
+        long index = testObjectSchemaInfo.getProperty("requiredLongList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllLongs(new long[] {1, 2, 3}, new boolean[] {false, false, false});
+
+        // Nothing is written if any of the values is null.
+        try {
+            osList.addAllLongs(new long[] {4, 0}, new boolean[] {false, true});
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        try {
+            osList.setRangeLongs(0, new long[] {4, 0}, new boolean[] {false, true});
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        assertEquals(3, osList.size());
+        assertEquals(1L, osList.getValue(0));
+    }
+
+    @Test
+    public void addAll_setRange_Double() {
+        long index = testObjectSchemaInfo.getProperty("requiredDoubleList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        osList.addAllDoubles(new double[] {1.5d, 2.5d}, null);
+        osList.setRangeDoubles(1, new double[] {3.5d}, null);
+        assertEquals(2, osList.size());
+        assertEquals(1.5d, (Double) osList.getValue(0), 0d);
+        assertEquals(3.5d, (Double) osList.getValue(1), 0d);
+    }
+
+    @Test
+    public void addAll_setRange_Float() {
+        long index = testObjectSchemaInfo.getProperty("floatList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        osList.addAllFloats(new float[] {1.5f, 0f}, new boolean[] {false, true});
+        assertEquals(1.5f, (Float) osList.getValue(0), 0f);
+        assertNull(osList.getValue(1));
+    }
+
+    @Test
+    public void addAll_setRange_Boolean() {
+        long index = testObjectSchemaInfo.getProperty("requiredBooleanList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        osList.addAllBooleans(new boolean[] {true, false, true}, null);
+        osList.setRangeBooleans(0, new boolean[] {false}, null);
+        assertEquals(3, osList.size());
+        assertEquals(false, osList.getValue(0));
+        assertEquals(true, osList.getValue(2));
+    }
+
+    @Test
+    public void addAll_setRange_String() {
+        long index = testObjectSchemaInfo.getProperty("stringList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        osList.addAllStrings(new String[] {"a", null, "c"});
+        osList.setRangeStrings(1, new String[] {"b", null});
+        assertEquals(3, osList.size());
+        assertEquals("a", osList.getValue(0));
+        assertEquals("b", osList.getValue(1));
+        assertNull(osList.getValue(2));
+    }
+
+    @Test
+    public void addAll_required_String_nullThrows() {
+        long index = testObjectSchemaInfo.getProperty("requiredStringList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        try {
+            osList.addAllStrings(new String[] {"a", null});
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        assertEquals(0, osList.size());
+    }
+
+    @Test
+    public void addAll_setRange_Binary() {
+        long index = testObjectSchemaInfo.getProperty("binaryList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        osList.addAllBinaries(new byte[][] {new byte[] {1}, null});
+        osList.setRangeBinaries(0, new byte[][] {new byte[] {2, 2}});
+        assertArrayEquals(new byte[] {2, 2}, (byte[]) osList.getValue(0));
+        assertNull(osList.getValue(1));
+    }
+
+    @Test
+    public void addAll_setRange_Date() {
+        long index = testObjectSchemaInfo.getProperty("dateList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        osList.addAllDates(new Date[] {new Date(42), null});
+        osList.setRangeDates(0, new Date[] {null, new Date(24)});
+        assertNull(osList.getValue(0));
+        assertEquals(new Date(24), osList.getValue(1));
+    }
+
+    @Test
+    public void addAll_wrongTypeThrows() {
+        long index = testObjectSchemaInfo.getProperty("longList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+
+        try {
+            osList.addAllDoubles(new double[] {1d}, null);
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        try {
+            osList.addAllStrings(new String[] {"1"});
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+        assertEquals(0, osList.size());
+    }
+
+    @Test
+    public void setRange_outOfBoundsThrows() {
+        long index = testObjectSchemaInfo.getProperty("longList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllLongs(new long[] {1, 2}, null);
+
+        try {
+            osList.setRangeLongs(1, new long[] {3, 4}, null);
+            fail();
+        } catch (ArrayIndexOutOfBoundsException ignored) {
+        }
+        assertEquals(2L, osList.getValue(1));
+    }
+
+    @Test
+    public void getLongs() {
+        long index = testObjectSchemaInfo.getProperty("longList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllLongs(new long[] {1, 2, 0, 4}, new boolean[] {false, false, true, false});
+
+        long[] values = new long[3];
+        boolean[] nulls = new boolean[3];
+        osList.getLongs(1, values, nulls);
+        assertArrayEquals(new long[] {2, 0, 4}, values);
+        assertArrayEquals(new boolean[] {false, true, false}, nulls);
+
+        // The null mask is optional.
+        values = new long[2];
+        osList.getLongs(0, values, null);
+        assertArrayEquals(new long[] {1, 2}, values);
+    }
+
+    @Test
+    public void getDoubles_getFloats_getBooleans() {
+        OsList doubleList = new OsList(row, testObjectSchemaInfo.getProperty("requiredDoubleList").getColumnIndex());
+        doubleList.addAllDoubles(new double[] {1.5d, 2.5d}, null);
+        double[] doubles = new double[2];
+        doubleList.getDoubles(0, doubles, null);
+        assertArrayEquals(new double[] {1.5d, 2.5d}, doubles, 0d);
+
+        OsList floatList = new OsList(row, testObjectSchemaInfo.getProperty("floatList").getColumnIndex());
+        floatList.addAllFloats(new float[] {0f, 3.5f}, new boolean[] {true, false});
+        float[] floats = new float[2];
+        boolean[] nulls = new boolean[2];
+        floatList.getFloats(0, floats, nulls);
+        assertArrayEquals(new float[] {0f, 3.5f}, floats, 0f);
+        assertArrayEquals(new boolean[] {true, false}, nulls);
+
+        OsList booleanList = new OsList(row, testObjectSchemaInfo.getProperty("requiredBooleanList").getColumnIndex());
+        booleanList.addAllBooleans(new boolean[] {true, false, true}, null);
+        boolean[] booleans = new boolean[2];
+        booleanList.getBooleans(1, booleans, null);
+        assertArrayEquals(new boolean[] {false, true}, booleans);
+    }
+
+    @Test
+    public void getTimestamps() {
+        long index = testObjectSchemaInfo.getProperty("dateList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllDates(new Date[] {new Date(42), null});
+
+        long[] values = new long[2];
+        boolean[] nulls = new boolean[2];
+        osList.getTimestamps(0, values, nulls);
+        assertArrayEquals(new long[] {42, 0}, values);
+        assertArrayEquals(new boolean[] {false, true}, nulls);
+    }
+
+    @Test
+    public void getStrings() {
+        long index = testObjectSchemaInfo.getProperty("stringList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllStrings(new String[] {"a", null, "c"});
+
+        String[] values = new String[3];
+        osList.getStrings(0, values);
+        assertArrayEquals(new String[] {"a", null, "c"}, values);
+    }
+
+    @Test
+    public void getLongs_outOfBoundsThrows() {
+        long index = testObjectSchemaInfo.getProperty("longList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllLongs(new long[] {1, 2}, null);
+
+        try {
+            osList.getLongs(1, new long[2], null);
+            fail();
+        } catch (ArrayIndexOutOfBoundsException ignored) {
+        }
+    }
+
+    @Test
+    public void getLongs_wrongTypeThrows() {
+        long index = testObjectSchemaInfo.getProperty("doubleList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllDoubles(new double[] {1d}, null);
+
+        try {
+            osList.getLongs(0, new long[1], null);
+            fail();
+        } catch (IllegalArgumentException ignored) {
+        }
+    }
+
+    @Test
+    public void applyPermutation_String() {
+        long index = testObjectSchemaInfo.getProperty("stringList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllStrings(new String[] {"a", "b", "c", "d"});
+
+        osList.applyPermutation(new int[] {2, 0, 3, 1});
+        String[] values = new String[4];
+        osList.getStrings(0, values);
+        assertArrayEquals(new String[] {"c", "a", "d", "b"}, values);
+    }
+
+    @Test
+    public void sortValues_Long() {
+        long index = testObjectSchemaInfo.getProperty("longList").getColumnIndex();
+        OsList osList = new OsList(row, index);
+        osList.addAllLongs(new long[] {3, 1, 0, 2}, new boolean[] {false, false, true, false});
+
+        osList.sortValues(true);
+        long[] values = new long[4];
+        boolean[] nulls = new boolean[4];
+        osList.getLongs(0, values, nulls);
+        assertArrayEquals(new boolean[] {true, false, false, false}, nulls);
+        assertArrayEquals(new long[] {0, 1, 2, 3}, values);
+
+        osList.sortValues(false);
+        osList.getLongs(0, values, nulls);
+        assertArrayEquals(new long[] {3, 2, 1, 0}, values);
+        assertArrayEquals(new boolean[] {false, false, false, true}, nulls);
+    }
 }
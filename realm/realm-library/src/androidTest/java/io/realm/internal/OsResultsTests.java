@@ -27,11 +27,16 @@ import org.junit.rules.ExpectedException;
 import org.junit.runner.RunWith;
 
 import java.lang.ref.WeakReference;
+import java.util.ArrayList;
 import java.util.ConcurrentModificationException;
+import java.util.List;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReference;
 
+import io.realm.OrderedCollectionChangeSet;
+import io.realm.OrderedRealmCollectionChangeListener;
 import io.realm.RealmChangeListener;
 import io.realm.RealmConfiguration;
 import io.realm.RealmFieldType;
@@ -46,6 +51,7 @@ import static junit.framework.Assert.assertEquals;
 import static junit.framework.Assert.assertFalse;
 import static junit.framework.Assert.assertTrue;
 import static junit.framework.Assert.fail;
+import static org.junit.Assert.assertArrayEquals;
 
 
 @RunWith(AndroidJUnit4.class)
@@ -187,6 +193,27 @@ public class OsResultsTests {
         assertEquals(4, osResults.size());
     }
 
+    @Test
+    public void size_queryFollowsChanges() {
+        OsResults osResults = OsResults.createFromQuery(sharedRealm,
+                table.where().equalTo(new long[] {1}, oneNullTable, "Lee"));
+        assertEquals(2, osResults.size());
+        assertEquals(2, osResults.size());
+
+        sharedRealm.beginTransaction();
+        long row = OsObject.createRow(table);
+        table.setString(1, row, "Lee", false);
+        assertEquals(3, osResults.size());
+        sharedRealm.commitTransaction();
+        assertEquals(3, osResults.size());
+
+        sharedRealm.beginTransaction();
+        table.setString(1, 0, "Smith", false);
+        sharedRealm.commitTransaction();
+        assertEquals(2, osResults.size());
+        assertEquals(2, osResults.size());
+    }
+
     @Test
     public void where() {
         OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where());
@@ -202,6 +229,75 @@ public class OsResultsTests {
         assertEquals(1, osResults3.size());
     }
 
+    @Test
+    public void where_chainsQueryWithoutEvaluatingResults() {
+        OsResults osResults = OsResults.createFromQuery(sharedRealm,
+                table.where().equalTo(new long[] {0}, oneNullTable, "John"));
+
+        long tableViewsBefore = NativeObjectStats.snapshot().getLiveCount(NativeObjectStats.TYPE_TABLE_VIEW);
+        TableQuery query = osResults.where().equalTo(new long[] {1}, oneNullTable, "Anderson");
+        // No TableView has been created for the intermediate results. Finalized views can only decrease the count.
+        assertTrue(NativeObjectStats.snapshot().getLiveCount(NativeObjectStats.TYPE_TABLE_VIEW) <= tableViewsBefore);
+
+        OsResults osResults2 = OsResults.createFromQuery(sharedRealm, query);
+        assertEquals(1, osResults2.size());
+
+        // The chained query still sees the rows added to the base results.
+        sharedRealm.beginTransaction();
+        long row = OsObject.createRow(table);
+        table.setString(0, row, "John", false);
+        table.setString(1, row, "Anderson", false);
+        sharedRealm.commitTransaction();
+        assertEquals(2, osResults2.size());
+    }
+
+    @Test
+    public void where_afterOr() {
+        OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where()
+                .equalTo(new long[] {0}, oneNullTable, "Erik")
+                .or()
+                .equalTo(new long[] {0}, oneNullTable, "Henry"));
+        assertEquals(2, osResults.size());
+
+        // The new predicate applies to both sides of the or(): "Erik Lee" doesn't match.
+        OsResults osResults2 = OsResults.createFromQuery(sharedRealm,
+                osResults.where().equalTo(new long[] {1}, oneNullTable, "Anderson"));
+        assertEquals(1, osResults2.size());
+        assertEquals("Henry", osResults2.getUncheckedRow(0).getString(0));
+    }
+
+    @Test
+    public void where_twiceAfterDistinct() {
+        OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where());
+        // Hashed, so the distinct results are backed by a query restricted to the distinct rows.
+        osResults.load();
+        OsResults distinct = osResults.distinct(QueryDescriptor.getInstanceForDistinct(null, table, "firstName"));
+        assertEquals(3, distinct.size()); // John Lee, Erik Lee and Henry Anderson.
+
+        OsResults osResults2 = OsResults.createFromQuery(sharedRealm,
+                distinct.where().equalTo(new long[] {1}, oneNullTable, "Lee"));
+        assertEquals(2, osResults2.size());
+
+        // John Anderson is still not part of the results.
+        OsResults osResults3 = OsResults.createFromQuery(sharedRealm,
+                osResults2.where().equalTo(new long[] {0}, oneNullTable, "John"));
+        assertEquals(1, osResults3.size());
+        assertEquals("Lee", osResults3.getUncheckedRow(0).getString(1));
+    }
+
+    @Test
+    public void where_keepsSortOrder() {
+        OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where())
+                .sort(QueryDescriptor.getTestInstance(table, new long[] {2}));
+
+        OsResults osResults2 = OsResults.createFromQuery(sharedRealm,
+                osResults.where().greaterThan(new long[] {2}, oneNullTable, 1));
+
+        assertEquals(2, osResults2.size());
+        assertEquals(3, osResults2.getUncheckedRow(0).getLong(2));
+        assertEquals(4, osResults2.getUncheckedRow(1).getLong(2));
+    }
+
     @Test
     public void sort() {
         OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where().greaterThan(new long[] {2}, oneNullTable, 1));
@@ -245,6 +341,82 @@ public class OsResultsTests {
         assertEquals(3, osResults.indexOf(row));
     }
 
+    @Test
+    public void indexOf_repeatedLookupsFollowChanges() {
+        DescriptorOrdering queryDescriptors = new DescriptorOrdering();
+        queryDescriptors.appendSort(QueryDescriptor.getTestInstance(table, new long[] {2}));
+        OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where(), queryDescriptors);
+        osResults.setPositionIndexEnabled(true);
+        UncheckedRow row = table.getUncheckedRow(0);
+
+        for (int i = 0; i < 3; i++) {
+            assertEquals(3, osResults.indexOf(row));
+            assertTrue(osResults.contains(row));
+        }
+
+        sharedRealm.beginTransaction();
+        table.setLong(2, 0, 0, false);
+        assertEquals(0, osResults.indexOf(row));
+        sharedRealm.commitTransaction();
+
+        for (int i = 0; i < 3; i++) {
+            assertEquals(0, osResults.indexOf(row));
+        }
+
+        osResults.setPositionIndexEnabled(false);
+        assertEquals(0, osResults.indexOf(row));
+        assertTrue(osResults.contains(row));
+    }
+
+    @Test
+    public void indexOf_repeatedLookupsInTableOrder() {
+        // Rows 0, 1 and 3 are kept as runs of consecutive rows.
+        OsResults osResults = OsResults.createFromQuery(sharedRealm,
+                table.where().notEqualTo(new long[] {0}, oneNullTable, "Erik"));
+        osResults.setPositionIndexEnabled(true);
+
+        for (int i = 0; i < 3; i++) {
+            assertEquals(0, osResults.indexOf(table.getUncheckedRow(0)));
+            assertEquals(1, osResults.indexOf(table.getUncheckedRow(1)));
+            assertEquals(2, osResults.indexOf(table.getUncheckedRow(3)));
+            assertFalse(osResults.contains(table.getUncheckedRow(2)));
+        }
+    }
+
+    @Test
+    public void contains_repeatedLookupsOfMissingRow() {
+        OsResults osResults = OsResults.createFromQuery(sharedRealm,
+                table.where().greaterThan(new long[] {2}, oneNullTable, 1));
+        osResults.setPositionIndexEnabled(true);
+        UncheckedRow row = table.getUncheckedRow(2);
+
+        for (int i = 0; i < 3; i++) {
+            assertFalse(osResults.contains(row));
+        }
+    }
+
+    @Test
+    public void indexOf_repeatedLookupsOfSparseRows() {
+        // Every other row matches, too many runs of one row are kept as a sorted vector.
+        sharedRealm.beginTransaction();
+        for (int i = 0; i < 200; i++) {
+            long row = OsObject.createRow(table);
+            table.setLong(2, row, 100 + (i % 2), false);
+        }
+        sharedRealm.commitTransaction();
+        OsResults osResults = OsResults.createFromQuery(sharedRealm,
+                table.where().equalTo(new long[] {2}, oneNullTable, 100));
+        osResults.setPositionIndexEnabled(true);
+
+        for (int i = 0; i < 3; i++) {
+            for (int position = 0; position < 100; position++) {
+                assertEquals(position, osResults.indexOf(table.getUncheckedRow(4 + position * 2)));
+            }
+            assertFalse(osResults.contains(table.getUncheckedRow(5)));
+            assertFalse(osResults.contains(table.getUncheckedRow(0)));
+        }
+    }
+
     @Test
     public void distinct() {
         OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where().lessThan(new long[] {2}, oneNullTable, 4));
@@ -261,6 +433,82 @@ public class OsResultsTests {
         assertEquals(1, osResults2.getUncheckedRow(1).getLong(2));
     }
 
+    @Test
+    public void distinct_multipleFields() {
+        sharedRealm.beginTransaction();
+        long row = OsObject.createRow(table);
+        table.setString(0, row, "Kim", false);
+        table.setString(1, row, "Anderson", false);
+        table.setLong(2, row, 1, false);
+        sharedRealm.commitTransaction();
+
+        OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where());
+        // Only results which have been evaluated already are hashed.
+        osResults.load();
+        QueryDescriptor distinctDescriptor = QueryDescriptor.getInstanceForDistinct(null, table,
+                new String[] {"lastName", "age"});
+
+        OsResults osResults2 = osResults.distinct(distinctDescriptor);
+
+        // The first row of every distinct value is kept in the original order.
+        assertEquals(4, osResults2.size());
+        for (int i = 0; i < 4; i++) {
+            assertEquals(i, osResults2.getUncheckedRow(i).getIndex());
+        }
+    }
+
+    @Test
+    public void distinct_sameResultsWhenSpillingToSort() {
+        QueryDescriptor sortDescriptor = QueryDescriptor.getTestInstance(table, new long[] {2});
+        OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where()).sort(sortDescriptor);
+        osResults.load();
+        QueryDescriptor distinctDescriptor = QueryDescriptor.getInstanceForDistinct(null, table, "lastName");
+
+        OsResults hashed = osResults.distinct(distinctDescriptor);
+        OsResults lazy = OsResults.createFromQuery(sharedRealm, table.where()).sort(sortDescriptor)
+                .distinct(distinctDescriptor);
+        OsResults spilled;
+        OsResults sorted;
+        // The first key already exceeds a limit of one byte.
+        OsResults.setHashDistinctMemoryLimit(1);
+        try {
+            spilled = osResults.distinct(distinctDescriptor);
+            OsResults.setHashDistinctMemoryLimit(0);
+            sorted = osResults.distinct(distinctDescriptor);
+        } finally {
+            OsResults.setHashDistinctMemoryLimit(8 * 1024 * 1024);
+        }
+
+        assertEquals(2, hashed.size());
+        for (OsResults other : new OsResults[] {lazy, spilled, sorted}) {
+            assertEquals(hashed.size(), other.size());
+            for (int i = 0; i < hashed.size(); i++) {
+                assertEquals(hashed.getUncheckedRow(i).getIndex(), other.getUncheckedRow(i).getIndex());
+            }
+        }
+    }
+
+    @Test
+    public void distinct_updatedAfterChange() {
+        OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where());
+        osResults.load();
+        OsResults osResults2 = osResults.distinct(QueryDescriptor.getInstanceForDistinct(null, table, "lastName"));
+        assertEquals(2, osResults2.size());
+
+        sharedRealm.beginTransaction();
+        long row = OsObject.createRow(table);
+        table.setString(1, row, "Smith", false);
+        sharedRealm.commitTransaction();
+
+        assertEquals(3, osResults2.size());
+        assertEquals("Smith", osResults2.getUncheckedRow(2).getString(1));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void setHashDistinctMemoryLimit_negativeThrows() {
+        OsResults.setHashDistinctMemoryLimit(-1);
+    }
+
     // 1. Create a results and add listener.
     // 2. Query results should be returned in the next loop.
     @Test
@@ -398,6 +646,67 @@ public class OsResultsTests {
         addRowAsync(sharedRealm);
     }
 
+    @Test
+    @RunTestInLooperThread
+    public void addListener_withKeyPathFilterStillNotifiesInsertions() {
+        final OsSharedRealm sharedRealm = getSharedRealmForLooper();
+        populateData(sharedRealm);
+        Table table = getTable(sharedRealm);
+
+        final OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where());
+        looperThread.keepStrongReference(osResults);
+        assertEquals(4, osResults.size()); // Trigger the query to run.
+        osResults.setKeyPathFilter(new String[] {"age"});
+        osResults.addListener(osResults, new RealmChangeListener<OsResults>() {
+            @Override
+            public void onChange(OsResults osResults1) {
+                assertEquals(5, osResults1.size());
+                sharedRealm.close();
+                looperThread.testComplete();
+            }
+        });
+
+        addRowAsync(sharedRealm);
+    }
+
+    @Test
+    public void addListener_withKeyPathFilterIgnoresOtherFields() {
+        final List<int[]> changes = new ArrayList<int[]>();
+        final OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where());
+        assertEquals(4, osResults.size()); // See `populateData()`
+        osResults.setKeyPathFilter(new String[] {"age"});
+        osResults.addListener(osResults, new OrderedRealmCollectionChangeListener<OsResults>() {
+            @Override
+            public void onChange(OsResults results, OrderedCollectionChangeSet changeSet) {
+                if (changeSet.getState() != OrderedCollectionChangeSet.State.INITIAL) {
+                    changes.add(changeSet.getChanges());
+                }
+            }
+        });
+
+        // Only the first name is outside of the filter.
+        sharedRealm.beginTransaction();
+        table.setString(0, 0, "Johnny", false);
+        sharedRealm.commitTransaction();
+        sharedRealm.refresh();
+        assertTrue(changes.isEmpty());
+
+        sharedRealm.beginTransaction();
+        table.setString(0, 0, "John", false);
+        table.setLong(2, 1, 30, false);
+        sharedRealm.commitTransaction();
+        sharedRealm.refresh();
+        assertEquals(1, changes.size());
+        assertArrayEquals(new int[] {1}, changes.get(0));
+    }
+
+    @Test
+    public void setKeyPathFilter_unknownFieldThrows() {
+        OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where());
+        thrown.expect(IllegalArgumentException.class);
+        osResults.setKeyPathFilter(new String[] {"age", "unknown.name"});
+    }
+
     // Local commit will trigger the listener first when beginTransaction gets called then again when transaction
     // committed.
     @Test
@@ -554,4 +863,105 @@ public class OsResultsTests {
         assertFalse(osResults.isLoaded());
         osResults.load();
     }
+
+    @Test
+    public void changeSet_getMoves() {
+        final AtomicReference<OsCollectionChangeSet> lastChangeSet = new AtomicReference<OsCollectionChangeSet>();
+        final OsResults osResults = OsResults.createFromQuery(sharedRealm, table.where());
+        assertEquals(4, osResults.size()); // See `populateData()`
+        osResults.addListener(osResults, new OrderedRealmCollectionChangeListener<OsResults>() {
+            @Override
+            public void onChange(OsResults results, OrderedCollectionChangeSet changeSet) {
+                lastChangeSet.set((OsCollectionChangeSet) changeSet);
+            }
+        });
+
+        // Removing the first row moves the last one ("Henry") into its place.
+        sharedRealm.beginTransaction();
+        table.moveLastOver(0);
+        sharedRealm.commitTransaction();
+        sharedRealm.refresh();
+
+        OsCollectionChangeSet changeSet = lastChangeSet.get();
+        assertArrayEquals(new int[] {3, 0}, changeSet.getMoves());
+        assertEquals(3, osResults.size());
+        assertEquals("Henry", osResults.getUncheckedRow(0).getString(0));
+        assertEquals(0, new EmptyLoadChangeSet(null, false).getMoves().length);
+    }
+
+    // Creates results which keep the raw change sets instead of notifying the listeners.
+    private OsResults createResultsKeepingChangeSets(DescriptorOrdering ordering, final List<Long> changeSetPtrs) {
+        OsResults osResults = new OsResults(sharedRealm, table,
+                OsResults.nativeCreateResults(sharedRealm.getNativePtr(), table.where().getNativePtr(),
+                        ordering.getNativePtr())) {
+            @Override
+            public void notifyChangeListeners(long nativeChangeSetPtr) {
+                // Keep the raw change sets, they are freed by OsCollectionChangeSet.coalesce().
+                if (nativeChangeSetPtr != 0) {
+                    changeSetPtrs.add(nativeChangeSetPtr);
+                }
+            }
+        };
+        assertEquals(4, osResults.size()); // See `populateData()`
+        osResults.addListener(osResults, new RealmChangeListener<OsResults>() {
+            @Override
+            public void onChange(OsResults element) {
+            }
+        });
+        return osResults;
+    }
+
+    @Test
+    public void changeSet_coalesce() {
+        final List<Long> changeSetPtrs = new ArrayList<Long>();
+        OsResults osResults = createResultsKeepingChangeSets(new DescriptorOrdering(), changeSetPtrs);
+
+        // Two commits delivered separately.
+        sharedRealm.beginTransaction();
+        OsObject.createRow(table);
+        sharedRealm.commitTransaction();
+        sharedRealm.refresh();
+        sharedRealm.beginTransaction();
+        OsObject.createRow(table);
+        sharedRealm.commitTransaction();
+        sharedRealm.refresh();
+        assertEquals(2, changeSetPtrs.size());
+
+        OsCollectionChangeSet changeSet = new OsCollectionChangeSet(
+                OsCollectionChangeSet.coalesce(changeSetPtrs.get(0), changeSetPtrs.get(1)), false);
+        assertArrayEquals(new int[] {4, 5}, changeSet.getInsertions());
+        assertEquals(0, changeSet.getDeletions().length);
+        assertEquals(0, changeSet.getChanges().length);
+        assertEquals(0, changeSet.getMoves().length);
+        assertEquals(6, osResults.size());
+    }
+
+    @Test
+    public void changeSet_coalesce_modificationAfterInsertion() {
+        final List<Long> changeSetPtrs = new ArrayList<Long>();
+        DescriptorOrdering ordering = new DescriptorOrdering();
+        ordering.appendSort(QueryDescriptor.getTestInstance(table, new long[] {2}));
+        // Sorted by age: Erik Lee, Henry Anderson, John Anderson, John Lee.
+        OsResults osResults = createResultsKeepingChangeSets(ordering, changeSetPtrs);
+
+        // The new row has age 0 and is inserted before John Lee, who moves from 3 to 4.
+        sharedRealm.beginTransaction();
+        OsObject.createRow(table);
+        table.setString(1, 0, "Li", false);
+        sharedRealm.commitTransaction();
+        sharedRealm.refresh();
+        // Erik Lee is at 1 now.
+        sharedRealm.beginTransaction();
+        table.setString(1, 2, "Larsen", false);
+        sharedRealm.commitTransaction();
+        sharedRealm.refresh();
+        assertEquals(2, changeSetPtrs.size());
+
+        OsCollectionChangeSet changeSet = new OsCollectionChangeSet(
+                OsCollectionChangeSet.coalesce(changeSetPtrs.get(0), changeSetPtrs.get(1)), false);
+        assertArrayEquals(new int[] {0}, changeSet.getInsertions());
+        assertEquals(0, changeSet.getDeletions().length);
+        assertArrayEquals(new int[] {1, 4}, changeSet.getChanges());
+        assertEquals(5, osResults.size());
+    }
 }
@@ -0,0 +1,118 @@
+###########################################################################
+#
+# Copyright 2019 Realm Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+###########################################################################
+
+# Generates the RegisterNatives() tables from the javah generated JNI headers.
+# Run in script mode:
+#   cmake -DJNI_HEADERS_DIR=<dir> -DOUTPUT_FILE=<file> -DFAST_NATIVES=<sym1,sym2,...>
+#         -P GenerateJniRegistration.cmake
+#
+# Every native method found in the headers gets an entry in the table of its class. Methods whose C symbol is listed
+# in FAST_NATIVES are flagged as candidates for the runtime's fast native calling convention, see
+# jni_util/native_methods.hpp.
+
+if (NOT JNI_HEADERS_DIR OR NOT OUTPUT_FILE)
+    message(FATAL_ERROR "JNI_HEADERS_DIR and OUTPUT_FILE must be defined.")
+endif()
+string(REPLACE "," ";" fast_natives "${FAST_NATIVES}")
+
+# Converts the mangled class name from javah (io_realm_internal_OsList) to a JNI class name (io/realm/internal/OsList).
+function(to_jni_class_name var mangled)
+    string(REPLACE "_00024" "$" name "${mangled}")
+    string(REPLACE "_1" "<UNDERSCORE>" name "${name}")
+    string(REPLACE "_" "/" name "${name}")
+    string(REPLACE "<UNDERSCORE>" "_" name "${name}")
+    set(${var} "${name}" PARENT_SCOPE)
+endfunction()
+
+file(GLOB header_files "${JNI_HEADERS_DIR}/*.h")
+list(SORT header_files)
+
+set(includes "")
+set(weak_decls "")
+set(tables "")
+set(classes "")
+
+foreach(header_file ${header_files})
+    file(READ "${header_file}" content)
+    # Signatures contain ';' which is the CMake list separator.
+    string(REPLACE ";" "<SEMICOLON>" content "${content}")
+    string(REGEX MATCHALL
+        "Class:[ ]+[A-Za-z0-9_]+[ ]*\n[ ]*\\*[ ]+Method:[ ]+[A-Za-z0-9_]+[ ]*\n[ ]*\\*[ ]+Signature:[ ]+[^\n ]+[ ]*\n[ ]*\\*/[ ]*\nJNIEXPORT [A-Za-z0-9_]+ JNICALL [A-Za-z0-9_]+"
+        entries "${content}")
+    if (NOT entries)
+        continue()
+    endif()
+
+    get_filename_component(header_name "${header_file}" NAME)
+    set(includes "${includes}#include \"${header_name}\"\n")
+
+    set(mangled_class "")
+    set(methods "")
+    set(method_count 0)
+    foreach(entry ${entries})
+        string(REGEX REPLACE "^Class:[ ]+([A-Za-z0-9_]+).*$" "\\1" mangled_class "${entry}")
+        string(REGEX REPLACE "^.*Method:[ ]+([A-Za-z0-9_]+).*$" "\\1" method_name "${entry}")
+        string(REGEX REPLACE "^.*Signature:[ ]+([^\n ]+).*$" "\\1" signature "${entry}")
+        string(REGEX REPLACE "^.*JNICALL ([A-Za-z0-9_]+)$" "\\1" symbol "${entry}")
+        string(REPLACE "<SEMICOLON>" ";" signature "${signature}")
+        string(REPLACE "_1" "_" method_name "${method_name}")
+
+        list(FIND fast_natives "${symbol}" fast_index)
+        if (fast_index EQUAL -1)
+            set(fast "false")
+        else()
+            set(fast "true")
+        endif()
+
+        # Natives declared in Java but not implemented are resolved to null and skipped at registration time.
+        set(weak_decls "${weak_decls}#pragma weak ${symbol}\n")
+        set(methods "${methods}    {\"${method_name}\", \"${signature}\", reinterpret_cast<void*>(&${symbol}), ${fast}},\n")
+        math(EXPR method_count "${method_count} + 1")
+    endforeach()
+
+    to_jni_class_name(class_name "${mangled_class}")
+    set(tables "${tables}static const NativeMethod ${mangled_class}_methods[] = {\n${methods}};\n\n")
+    set(classes "${classes}    {\"${class_name}\", ${mangled_class}_methods, ${method_count}},\n")
+endforeach()
+
+set(generated "// This file is generated by CMake/GenerateJniRegistration.cmake. DO NOT EDIT.
+
+#include \"jni_util/native_methods.hpp\"
+
+${includes}
+${weak_decls}
+namespace realm {
+namespace jni_util {
+
+${tables}const NativeClass g_native_classes[] = {
+${classes}};
+
+const size_t g_native_classes_count = sizeof(g_native_classes) / sizeof(g_native_classes[0]);
+
+} // namespace jni_util
+} // namespace realm
+")
+
+# Only touch the output when it has changed to avoid recompiling it for every build.
+if (EXISTS "${OUTPUT_FILE}")
+    file(READ "${OUTPUT_FILE}" old_generated)
+    if (old_generated STREQUAL generated)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT_FILE}" "${generated}")
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "column_index_cache.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "java_accessor.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+namespace {
+
+// Names up to this length are read from Java without allocating.
+constexpr jsize stack_name_length = 64;
+// The cache is dropped as a whole once it knows this many tables, which only happens if table accessors keep being
+// recreated, e.g. by opening and closing Realms.
+constexpr size_t max_cached_tables = 128;
+
+struct CachedColumn {
+    std::u16string java_name;
+    std::string name;
+    size_t index;
+};
+
+// Keyed by the hash of the UTF-16 name. A collision is handled as a miss and replaces the entry.
+typedef std::unordered_map<size_t, CachedColumn> ColumnMap;
+
+// Table accessors belong to the thread of their Realm, so each thread has its own cache and no lock is needed.
+thread_local std::unordered_map<const Table*, ColumnMap> s_tables;
+
+size_t hash_name(const jchar* chars, jsize length)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (jsize i = 0; i < length; ++i) {
+        hash = (hash ^ chars[i]) * 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool is_valid_hit(const CachedColumn& column, const Table& table, const jchar* chars, jsize length)
+{
+    return column.java_name.size() == static_cast<size_t>(length) &&
+           std::memcmp(column.java_name.data(), chars, static_cast<size_t>(length) * sizeof(jchar)) == 0 &&
+           column.index < table.get_column_count() && table.get_column_name(column.index) == column.name;
+}
+
+} // anonymous namespace
+
+size_t realm::_impl::find_column_index(JNIEnv* env, const Table& table, jstring column_name)
+{
+    if (!column_name) {
+        return realm::not_found;
+    }
+    jsize length = env->GetStringLength(column_name);
+    jchar stack_chars[stack_name_length];
+    std::unique_ptr<jchar[]> heap_chars;
+    jchar* chars = stack_chars;
+    if (length > stack_name_length) {
+        heap_chars.reset(new jchar[length]);
+        chars = heap_chars.get();
+    }
+    env->GetStringRegion(column_name, 0, length, chars);
+    size_t hash = hash_name(chars, length);
+
+    auto table_it = s_tables.find(&table);
+    if (table_it != s_tables.end()) {
+        auto it = table_it->second.find(hash);
+        if (it != table_it->second.end() && is_valid_hit(it->second, table, chars, length)) {
+            return it->second.index;
+        }
+    }
+
+    JStringAccessor name(env, column_name); // throws
+    size_t index = table.get_column_index(name);
+    if (index == realm::not_found) {
+        return index;
+    }
+
+    if (s_tables.size() >= max_cached_tables && s_tables.find(&table) == s_tables.end()) {
+        s_tables.clear();
+    }
+    s_tables[&table][hash] =
+        CachedColumn{std::u16string(reinterpret_cast<const char16_t*>(chars), static_cast<size_t>(length)),
+                     std::string(name), index};
+    return index;
+}
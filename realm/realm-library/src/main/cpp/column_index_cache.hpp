@@ -0,0 +1,42 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_COLUMN_INDEX_CACHE_HPP
+#define REALM_JNI_IMPL_COLUMN_INDEX_CACHE_HPP
+
+#include <jni.h>
+
+#include <cstddef>
+
+#include <realm/table.hpp>
+
+namespace realm {
+namespace _impl {
+
+// Returns the index of the column with the given name, or realm::not_found. Used by the getColumnIndex() calls of
+// Table and the Row classes, which are made for every field access of a DynamicRealmObject.
+//
+// Core searches the column names linearly, after the name has been converted to UTF-8 into a new buffer. The indices
+// found are cached per thread and table, keyed by the UTF-16 name read from Java into a stack buffer, so a repeated
+// lookup doesn't allocate. Table accessors might be reused for another table, and columns might be added, removed or
+// moved, so every hit is checked against the current name of the column at the cached index; a stale entry is just a
+// miss.
+size_t find_column_index(JNIEnv* env, const Table& table, jstring column_name);
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_COLUMN_INDEX_CACHE_HPP
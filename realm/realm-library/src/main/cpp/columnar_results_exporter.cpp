@@ -0,0 +1,256 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "columnar_results_exporter.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <object_schema.hpp>
+
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+namespace {
+
+constexpr size_t buffer_alignment = 64;
+
+size_t aligned(size_t size)
+{
+    return (size + buffer_alignment - 1) / buffer_alignment * buffer_alignment;
+}
+
+inline bool is_null(const RowExpr& row, const ColumnarResultsExporter::Column& column)
+{
+    return !row.is_attached() || (is_nullable(column.type) && row.is_null(column.table_column));
+}
+
+inline size_t variable_width_size(const RowExpr& row, const ColumnarResultsExporter::Column& column)
+{
+    if ((column.type & ~PropertyType::Flags) == PropertyType::String) {
+        return row.get_string(column.table_column).size();
+    }
+    return row.get_binary(column.table_column).size();
+}
+
+inline void set_bit(char* bitmap, size_t index)
+{
+    bitmap[index / 8] |= static_cast<char>(1 << (index % 8));
+}
+
+template <typename T>
+inline void store(char* values, size_t index, T value)
+{
+    // The buffers are only aligned relative to the start of the output.
+    std::memcpy(values + index * sizeof(T), &value, sizeof(T));
+}
+
+[[noreturn]] void throw_changed()
+{
+    throw std::logic_error("The objects have been changed since the columnar layout was computed.");
+}
+
+} // anonymous namespace
+
+bool realm::_impl::is_columnar_type(PropertyType type)
+{
+    if (is_array(type)) {
+        return false;
+    }
+    switch (type & ~PropertyType::Flags) {
+        case PropertyType::Int:
+        case PropertyType::Bool:
+        case PropertyType::Float:
+        case PropertyType::Double:
+        case PropertyType::String:
+        case PropertyType::Data:
+        case PropertyType::Date:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool realm::_impl::is_variable_width(PropertyType type)
+{
+    PropertyType base_type = type & ~PropertyType::Flags;
+    return base_type == PropertyType::String || base_type == PropertyType::Data;
+}
+
+size_t realm::_impl::columnar_values_size(PropertyType type, size_t row_count)
+{
+    switch (type & ~PropertyType::Flags) {
+        case PropertyType::Bool:
+            return (row_count + 7) / 8;
+        case PropertyType::Float:
+            return row_count * sizeof(float);
+        case PropertyType::String:
+        case PropertyType::Data:
+            return (row_count + 1) * sizeof(int32_t);
+        default:
+            return row_count * sizeof(int64_t);
+    }
+}
+
+ColumnarResultsExporter::ColumnarResultsExporter(const Results& results, const std::vector<std::string>& properties)
+    : m_results(results.snapshot())
+    , m_row_count(m_results.size())
+{
+    const ObjectSchema& object_schema = m_results.get_object_schema();
+    m_columns.reserve(properties.size());
+    for (const std::string& name : properties) {
+        const Property* property = object_schema.property_for_name(name);
+        if (!property) {
+            throw std::invalid_argument(
+                util::format("Property '%1' cannot be found in class '%2'.", name, object_schema.name));
+        }
+        if (!is_columnar_type(property->type)) {
+            throw std::invalid_argument(util::format("Property '%1' of type '%2' cannot be exported as a column.",
+                                                     name, string_for_property_type(property->type)));
+        }
+        Column column;
+        column.name = name;
+        column.type = property->type;
+        column.table_column = property->table_column;
+        m_columns.push_back(std::move(column));
+    }
+    compute_layout();
+}
+
+void ColumnarResultsExporter::compute_layout()
+{
+    // All columns are measured in one pass over the objects.
+    std::vector<size_t> data_sizes(m_columns.size(), 0);
+    for (size_t i = 0; i < m_row_count; ++i) {
+        RowExpr row = m_results.get(i);
+        for (size_t j = 0; j < m_columns.size(); ++j) {
+            Column& column = m_columns[j];
+            if (is_null(row, column)) {
+                ++column.null_count;
+            }
+            else if (is_variable_width(column.type)) {
+                data_sizes[j] += variable_width_size(row, column);
+            }
+        }
+    }
+
+    size_t offset = 0;
+    auto place = [&](Buffer& buffer, size_t size) {
+        buffer.offset = offset;
+        buffer.size = size;
+        offset += aligned(size);
+    };
+    for (size_t j = 0; j < m_columns.size(); ++j) {
+        Column& column = m_columns[j];
+        if (data_sizes[j] > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+            throw std::invalid_argument(
+                util::format("The values of property '%1' are too large for 32 bit offsets.", column.name));
+        }
+        if (column.null_count != 0) {
+            place(column.validity, (m_row_count + 7) / 8);
+        }
+        place(column.values, columnar_values_size(column.type, m_row_count));
+        if (is_variable_width(column.type)) {
+            place(column.data, data_sizes[j]);
+        }
+    }
+    m_required_size = offset;
+}
+
+void ColumnarResultsExporter::write(char* out, size_t size)
+{
+    if (size < m_required_size) {
+        throw std::invalid_argument(
+            util::format("The columns need %1 bytes, but only %2 bytes are available.", m_required_size, size));
+    }
+    // Takes care of the padding, the null bits and the false booleans.
+    std::memset(out, 0, m_required_size);
+
+    std::vector<size_t> null_counts(m_columns.size(), 0);
+    std::vector<size_t> data_positions(m_columns.size(), 0);
+    auto append_data = [&](const Column& column, size_t column_index, size_t row_index, const char* data,
+                           size_t data_size) {
+        size_t& position = data_positions[column_index];
+        if (data_size > column.data.size - position) {
+            throw_changed();
+        }
+        if (data_size != 0) {
+            std::memcpy(out + column.data.offset + position, data, data_size);
+        }
+        position += data_size;
+        store(out + column.values.offset, row_index + 1, static_cast<int32_t>(position));
+    };
+    for (size_t i = 0; i < m_row_count; ++i) {
+        RowExpr row = m_results.get(i);
+        for (size_t j = 0; j < m_columns.size(); ++j) {
+            const Column& column = m_columns[j];
+            char* values = out + column.values.offset;
+            size_t col = column.table_column;
+            if (is_null(row, column)) {
+                if (++null_counts[j] > column.null_count) {
+                    throw_changed();
+                }
+                if (is_variable_width(column.type)) {
+                    store(values, i + 1, static_cast<int32_t>(data_positions[j]));
+                }
+                continue;
+            }
+            if (column.validity.size != 0) {
+                set_bit(out + column.validity.offset, i);
+            }
+            switch (column.type & ~PropertyType::Flags) {
+                case PropertyType::Int:
+                    store(values, i, row.get_int(col));
+                    break;
+                case PropertyType::Bool:
+                    if (row.get_bool(col)) {
+                        set_bit(values, i);
+                    }
+                    break;
+                case PropertyType::Float:
+                    store(values, i, row.get_float(col));
+                    break;
+                case PropertyType::Double:
+                    store(values, i, row.get_double(col));
+                    break;
+                case PropertyType::Date:
+                    store(values, i, static_cast<int64_t>(to_milliseconds(row.get_timestamp(col))));
+                    break;
+                case PropertyType::String: {
+                    StringData value = row.get_string(col);
+                    append_data(column, j, i, value.data(), value.size());
+                    break;
+                }
+                case PropertyType::Data: {
+                    BinaryData value = row.get_binary(col);
+                    append_data(column, j, i, value.data(), value.size());
+                    break;
+                }
+                default:
+                    REALM_UNREACHABLE();
+            }
+        }
+    }
+    for (size_t j = 0; j < m_columns.size(); ++j) {
+        if (null_counts[j] != m_columns[j].null_count) {
+            throw_changed();
+        }
+    }
+}
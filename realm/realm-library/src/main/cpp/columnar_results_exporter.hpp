@@ -0,0 +1,108 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_COLUMNAR_RESULTS_EXPORTER_HPP
+#define REALM_JNI_IMPL_COLUMNAR_RESULTS_EXPORTER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <property.hpp>
+#include <results.hpp>
+
+namespace realm {
+namespace _impl {
+
+// Whether properties of the given type can be exported and imported as columns.
+bool is_columnar_type(PropertyType type);
+
+// Whether a column of the given type has offsets in its values buffer and a data buffer.
+bool is_variable_width(PropertyType type);
+
+// The size of the values buffer of a column of the given type.
+size_t columnar_values_size(PropertyType type, size_t row_count);
+
+// Exports properties of the objects in a Results as columns in the Apache Arrow memory layout, so the data can be
+// handed over to vectorized code without converting it row by row. Each column is made of:
+// - a validity bitmap, one bit per row in least significant bit order, 1 for a value and 0 for null. It is left out
+//   (size 0) if the column has no nulls.
+// - a values buffer: int64 for Int, bit packed booleans for Bool, float32 for Float, float64 for Double and int64
+//   milliseconds since the epoch for Date. For String and Data it holds the int32 offsets (row count + 1 of them)
+//   into the data buffer.
+// - a data buffer with the UTF-8 strings or bytes, only used by String and Data.
+// All buffers start at a multiple of 64 bytes from the beginning of the output and are zero padded to a multiple of
+// 64 bytes, as recommended by Arrow. Values are written in the native byte order, which is little endian on all
+// supported ABIs.
+//
+// The objects are taken from a snapshot of the Results when the exporter is created and the layout is computed
+// right away, so the caller can allocate the output before calling write(). Must be used on the thread of the Realm.
+class ColumnarResultsExporter {
+public:
+    struct Buffer {
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+    struct Column {
+        std::string name;
+        PropertyType type;
+        size_t table_column;
+        size_t null_count = 0;
+        Buffer validity;
+        Buffer values;
+        Buffer data;
+    };
+
+    // Throws std::invalid_argument if a property doesn't exist or is a list or a link, which have no columnar
+    // representation here.
+    ColumnarResultsExporter(const Results& results, const std::vector<std::string>& properties);
+
+    size_t row_count() const noexcept
+    {
+        return m_row_count;
+    }
+
+    const std::vector<Column>& columns() const noexcept
+    {
+        return m_columns;
+    }
+
+    // The number of bytes needed by write().
+    size_t required_size() const noexcept
+    {
+        return m_required_size;
+    }
+
+    // Writes all columns into out, which must have room for required_size() bytes. Throws std::logic_error if the
+    // objects have been changed in a way which doesn't fit the layout computed before, e.g. a longer string has been
+    // set in a write transaction in the meantime.
+    void write(char* out, size_t size);
+
+private:
+    // A snapshot, the objects deleted in the meantime have all their values exported as null.
+    Results m_results;
+    size_t m_row_count;
+    std::vector<Column> m_columns;
+    size_t m_required_size = 0;
+
+    void compute_layout();
+};
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_COLUMNAR_RESULTS_EXPORTER_HPP
@@ -0,0 +1,340 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "columnar_table_importer.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_set>
+
+#if REALM_ENABLE_SYNC
+#include <realm/sync/object.hpp>
+#endif
+
+#include <object_schema.hpp>
+
+#include "columnar_results_exporter.hpp"
+#include "schema_cache.hpp"
+#include "util.hpp"
+
+#include "jni_util/java_exception_thrower.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+namespace {
+
+const char* const pk_constraint_exception_class = "io/realm/exceptions/RealmPrimaryKeyConstraintException";
+
+// An input column mapped to its property.
+struct MappedColumn {
+    const ColumnarImportColumn* input;
+    const Property* property;
+    PropertyType type;
+    size_t col;
+};
+
+template <typename T>
+inline T load(const BinaryData& buffer, size_t index)
+{
+    // The buffers might not be aligned.
+    T value;
+    std::memcpy(&value, buffer.data() + index * sizeof(T), sizeof(T));
+    return value;
+}
+
+inline bool is_null_at(const ColumnarImportColumn& column, size_t row)
+{
+    return column.validity.size() != 0 &&
+           ((static_cast<unsigned char>(column.validity.data()[row / 8]) >> (row % 8)) & 1) == 0;
+}
+
+inline bool bit_at(const BinaryData& buffer, size_t row)
+{
+    return ((static_cast<unsigned char>(buffer.data()[row / 8]) >> (row % 8)) & 1) != 0;
+}
+
+inline const char* data_at(const ColumnarImportColumn& column, size_t row, size_t& size)
+{
+    auto begin = static_cast<size_t>(load<int32_t>(column.values, row));
+    size = static_cast<size_t>(load<int32_t>(column.values, row + 1)) - begin;
+    return column.data.data() + begin;
+}
+
+inline StringData string_at(const ColumnarImportColumn& column, size_t row)
+{
+    if (is_null_at(column, row)) {
+        return StringData();
+    }
+    size_t size;
+    const char* data = data_at(column, row, size);
+    // A non null StringData, even if empty.
+    return StringData(size == 0 ? "" : data, size);
+}
+
+void validate_column(const MappedColumn& column, size_t row_count)
+{
+    const ColumnarImportColumn& input = *column.input;
+    const std::string& name = column.property->name;
+    if (input.validity.size() != 0 && input.validity.size() < (row_count + 7) / 8) {
+        throw std::invalid_argument(util::format("The validity bitmap of '%1' is too small.", name));
+    }
+    if (input.values.size() < columnar_values_size(column.type, row_count)) {
+        throw std::invalid_argument(util::format("The values of '%1' are too small.", name));
+    }
+    if (input.validity.size() != 0 && !is_nullable(column.property->type)) {
+        for (size_t i = 0; i < row_count; ++i) {
+            if (is_null_at(input, i)) {
+                throw std::invalid_argument(
+                    util::format("Property '%1' is not nullable, but the value at %2 is null.", name, i));
+            }
+        }
+    }
+    if (is_variable_width(column.type)) {
+        int32_t previous = load<int32_t>(input.values, 0);
+        if (previous < 0) {
+            throw std::invalid_argument(util::format("Invalid offset %1 at 0 in '%2'.", previous, name));
+        }
+        for (size_t i = 1; i <= row_count; ++i) {
+            int32_t offset = load<int32_t>(input.values, i);
+            if (offset < previous || static_cast<size_t>(offset) > input.data.size()) {
+                throw std::invalid_argument(util::format("Invalid offset %1 at %2 in '%3'.", offset, i, name));
+            }
+            previous = offset;
+        }
+    }
+}
+
+// The primary key of one object of the import.
+struct PrimaryKeyValue {
+    bool is_int;
+    bool is_null;
+    int64_t int_value;
+    StringData string_value;
+};
+
+PrimaryKeyValue primary_key_at(const MappedColumn& pk, size_t row)
+{
+    const ColumnarImportColumn& input = *pk.input;
+    PrimaryKeyValue value;
+    value.is_int = pk.type == PropertyType::Int;
+    value.is_null = is_null_at(input, row);
+    value.string_value = value.is_int ? StringData() : string_at(input, row);
+    value.int_value = value.is_int && !value.is_null ? load<int64_t>(input.values, row) : 0;
+    return value;
+}
+
+size_t find_primary_key(const Table& table, const MappedColumn& pk, const PrimaryKeyValue& value)
+{
+    if (value.is_null) {
+        return table.find_first_null(pk.col);
+    }
+    if (value.is_int) {
+        return table.find_first_int(pk.col, value.int_value);
+    }
+    return table.find_first_string(pk.col, value.string_value);
+}
+
+// Throws the RealmPrimaryKeyConstraintException for a primary key which exists already or appears twice in the
+// columns. Only needed when existing objects are not updated, and done before anything is written.
+void check_primary_keys(JNIEnv* env, const Table& table, const MappedColumn& pk, size_t row_count)
+{
+    bool seen_null = false;
+    std::unordered_set<int64_t> seen_ints;
+    std::unordered_set<std::string> seen_strings;
+    for (size_t row = 0; row < row_count; ++row) {
+        PrimaryKeyValue value = primary_key_at(pk, row);
+        bool duplicate;
+        if (value.is_null) {
+            duplicate = seen_null;
+            seen_null = true;
+        }
+        else if (value.is_int) {
+            duplicate = !seen_ints.insert(value.int_value).second;
+        }
+        else {
+            duplicate = !seen_strings.insert(std::string(value.string_value)).second;
+        }
+        if (duplicate || find_primary_key(table, pk, value) != realm::npos) {
+            std::string text = value.is_null ? "'null'"
+                                             : value.is_int ? util::format("%1", value.int_value)
+                                                            : std::string(value.string_value);
+            THROW_JAVA_EXCEPTION(env, pk_constraint_exception_class,
+                                 util::format("Primary key value already exists: %1 .", text));
+        }
+    }
+}
+
+size_t find_or_create_object(SharedRealm& realm, Table& table, const MappedColumn& pk, size_t row, bool& created)
+{
+    PrimaryKeyValue value = primary_key_at(pk, row);
+    bool is_int = value.is_int;
+    bool is_null = value.is_null;
+    int64_t int_value = value.int_value;
+    StringData string_value = value.string_value;
+
+    size_t existing = find_primary_key(table, pk, value);
+    created = existing == realm::npos;
+    if (!created) {
+        // Only reachable when updating, check_primary_keys() has rejected existing keys otherwise.
+        return existing;
+    }
+
+#if REALM_ENABLE_SYNC
+    if (is_int) {
+        return sync::create_object_with_primary_key(realm->read_group(), table,
+                                                    is_null ? util::none : util::Optional<int64_t>(int_value));
+    }
+    return sync::create_object_with_primary_key(realm->read_group(), table, string_value);
+#else
+    static_cast<void>(realm);
+    size_t row_ndx = table.add_empty_row();
+    if (is_null) {
+        table.set_null_unique(pk.col, row_ndx);
+    }
+    else if (is_int) {
+        table.set_int_unique(pk.col, row_ndx, int_value);
+    }
+    else {
+        table.set_string_unique(pk.col, row_ndx, string_value);
+    }
+    return row_ndx;
+#endif
+}
+
+void write_column(Table& table, const MappedColumn& column, const std::vector<size_t>& rows)
+{
+    const ColumnarImportColumn& input = *column.input;
+    size_t col = column.col;
+    size_t row_count = rows.size();
+    for (size_t i = 0; i < row_count; ++i) {
+        if (is_null_at(input, i)) {
+            table.set_null(col, rows[i]);
+            continue;
+        }
+        switch (column.type) {
+            case PropertyType::Int:
+                table.set_int(col, rows[i], load<int64_t>(input.values, i));
+                break;
+            case PropertyType::Bool:
+                table.set_bool(col, rows[i], bit_at(input.values, i));
+                break;
+            case PropertyType::Float:
+                table.set_float(col, rows[i], load<float>(input.values, i));
+                break;
+            case PropertyType::Double:
+                table.set_double(col, rows[i], load<double>(input.values, i));
+                break;
+            case PropertyType::Date:
+                table.set_timestamp(col, rows[i], from_milliseconds(load<int64_t>(input.values, i)));
+                break;
+            case PropertyType::String:
+                table.set_string(col, rows[i], string_at(input, i));
+                break;
+            case PropertyType::Data: {
+                size_t size;
+                const char* data = data_at(input, i, size);
+                table.set_binary(col, rows[i], BinaryData(size == 0 ? "" : data, size));
+                break;
+            }
+            default:
+                REALM_UNREACHABLE();
+        }
+    }
+}
+
+} // anonymous namespace
+
+size_t realm::_impl::import_columns(JNIEnv* env, SharedRealm& realm, Table& table,
+                                    const std::vector<ColumnarImportColumn>& columns, size_t row_count,
+                                    bool update_existing)
+{
+    realm->verify_in_write();
+    const ObjectSchema& object_schema = object_schema_for_table(realm, table);
+
+    // Map the columns to the properties and check all buffers before anything is written.
+    std::vector<MappedColumn> mapped_columns;
+    mapped_columns.reserve(columns.size());
+    const MappedColumn* pk_column = nullptr;
+    for (const ColumnarImportColumn& input : columns) {
+        const Property* property = object_schema.property_for_name(input.property_name);
+        if (!property) {
+            throw std::invalid_argument(util::format("Property '%1' cannot be found in class '%2'.",
+                                                     input.property_name, object_schema.name));
+        }
+        if (!is_columnar_type(property->type)) {
+            throw std::invalid_argument(util::format("Property '%1' of type '%2' cannot be imported from a column.",
+                                                     property->name, string_for_property_type(property->type)));
+        }
+        for (const MappedColumn& other : mapped_columns) {
+            if (other.property == property) {
+                throw std::invalid_argument(util::format("Property '%1' is imported twice.", property->name));
+            }
+        }
+        mapped_columns.push_back({&input, property, property->type & ~PropertyType::Flags, property->table_column});
+        validate_column(mapped_columns.back(), row_count);
+    }
+    const Property* pk_property = object_schema.primary_key_property();
+    if (pk_property) {
+        for (const MappedColumn& column : mapped_columns) {
+            if (column.property == pk_property) {
+                pk_column = &column;
+            }
+        }
+        if (!pk_column) {
+            throw std::invalid_argument(util::format("The primary key '%1' of class '%2' must be imported.",
+                                                     pk_property->name, object_schema.name));
+        }
+    }
+
+    if (pk_column && !update_existing) {
+        check_primary_keys(env, table, *pk_column, row_count);
+    }
+
+    // Resolve the row of every object first, then write the values column by column.
+    std::vector<size_t> rows(row_count);
+    size_t created_count = 0;
+    if (pk_column) {
+        for (size_t i = 0; i < row_count; ++i) {
+            bool created;
+            rows[i] = find_or_create_object(realm, table, *pk_column, i, created);
+            if (created) {
+                ++created_count;
+            }
+        }
+    }
+    else if (row_count != 0) {
+#if REALM_ENABLE_SYNC
+        for (size_t i = 0; i < row_count; ++i) {
+            rows[i] = sync::create_object(realm->read_group(), table);
+        }
+#else
+        size_t first_row = table.add_empty_row(row_count);
+        for (size_t i = 0; i < row_count; ++i) {
+            rows[i] = first_row + i;
+        }
+#endif
+        created_count = row_count;
+    }
+
+    for (const MappedColumn& column : mapped_columns) {
+        if (&column != pk_column) {
+            write_column(table, column, rows);
+        }
+    }
+    return created_count;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_COLUMNAR_TABLE_IMPORTER_HPP
+#define REALM_JNI_IMPL_COLUMNAR_TABLE_IMPORTER_HPP
+
+#include <jni.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <realm/binary_data.hpp>
+#include <realm/table.hpp>
+
+#include <shared_realm.hpp>
+
+namespace realm {
+namespace _impl {
+
+// One column of a columnar import, in the layout written by ColumnarResultsExporter. The validity bitmap is empty if
+// the column has no nulls, the data buffer is only used by String and Data columns.
+struct ColumnarImportColumn {
+    std::string property_name;
+    BinaryData validity;
+    BinaryData values;
+    BinaryData data;
+};
+
+// Writes row_count objects given as columns into the table of a class. Every column is mapped to its property once
+// and then written in one go, so the cost of the JNI calls doesn't depend on the number of objects.
+//
+// If the class has a primary key, it must be one of the columns. Objects whose primary key already exists are updated
+// if update_existing is true, otherwise a RealmPrimaryKeyConstraintException is thrown, as it is for a primary key
+// appearing twice in the columns. Properties without a column keep their default value in new objects and their
+// current value in updated ones. All buffers and primary keys are checked before anything is written and
+// std::invalid_argument is thrown if the buffers don't match the schema, e.g. a null in a required property or offsets
+// out of range.
+//
+// Must be called in a write transaction. Returns the number of objects created.
+size_t import_columns(JNIEnv* env, SharedRealm& realm, Table& table, const std::vector<ColumnarImportColumn>& columns,
+                      size_t row_count, bool update_existing);
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_COLUMNAR_TABLE_IMPORTER_HPP
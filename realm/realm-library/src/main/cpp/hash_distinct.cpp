@@ -0,0 +1,190 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hash_distinct.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include <realm/query.hpp>
+#include <realm/table.hpp>
+#include <realm/table_view.hpp>
+
+using namespace realm;
+using namespace realm::_impl;
+
+namespace {
+
+// 8 MB is enough for a few hundred thousand distinct short keys while staying well below the heap size of a device.
+std::atomic<size_t> s_memory_limit(8 * 1024 * 1024);
+
+// Rough per key overhead of the std::unordered_set node, its bucket and the kept row index.
+constexpr size_t entry_overhead = sizeof(std::string) + 3 * sizeof(void*) + sizeof(size_t);
+
+// Builds a view with a given subset of the rows of another view. The DistinctDescriptor is appended to the ordering
+// of the view, so syncing it later recomputes the same rows with Core's distinct.
+class DistinctTableView : public TableView {
+public:
+    DistinctTableView(TableView&& view, const std::vector<size_t>& rows, DistinctDescriptor descriptor)
+        : TableView(std::move(view))
+    {
+        m_row_indexes.clear();
+        for (size_t row : rows) {
+            m_row_indexes.add(static_cast<int64_t>(row));
+        }
+        m_descriptor_ordering.append_distinct(std::move(descriptor));
+    }
+};
+
+// The view is internal to the Results, it is not tracked as a Java owned TableView.
+Results results_for_view(const SharedRealm& realm, Table& table, TableView view)
+{
+    Query query(table, std::unique_ptr<TableViewBase>(new TableView(std::move(view))));
+    return Results(realm, std::move(query));
+}
+
+template <typename T>
+inline void append_raw(std::string& key, T value)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    key.append(bytes, sizeof(T));
+}
+
+// Appends the value of a cell to the key. Every value is prefixed by a null marker and strings by their size, so the
+// concatenated values of different rows are equal only if all the values are.
+void append_value(std::string& key, const Table& table, DataType type, size_t column, size_t row)
+{
+    if (table.is_nullable(column) && table.is_null(column, row)) {
+        key.push_back(0);
+        return;
+    }
+    key.push_back(1);
+    switch (type) {
+        case type_Int:
+            append_raw(key, table.get_int(column, row));
+            break;
+        case type_Bool:
+            key.push_back(table.get_bool(column, row) ? 1 : 0);
+            break;
+        case type_Timestamp: {
+            Timestamp timestamp = table.get_timestamp(column, row);
+            append_raw(key, timestamp.get_seconds());
+            append_raw(key, timestamp.get_nanoseconds());
+            break;
+        }
+        case type_String: {
+            StringData string = table.get_string(column, row);
+            append_raw(key, string.size());
+            key.append(string.data(), string.size());
+            break;
+        }
+        default:
+            REALM_UNREACHABLE();
+    }
+}
+
+} // anonymous namespace
+
+util::Optional<Results> realm::_impl::hash_distinct(Results& results,
+                                                     const std::vector<std::vector<size_t>>& column_paths,
+                                                     DistinctDescriptor descriptor)
+{
+    const size_t memory_limit = get_hash_distinct_memory_limit();
+    // Results which haven't been evaluated yet are left to Core, which applies the distinct lazily when they are.
+    if (memory_limit == 0 || column_paths.empty() || results.get_mode() != Results::Mode::TableView) {
+        return util::none;
+    }
+
+    TableView view = results.get_tableview();
+    Table& table = view.get_parent();
+
+    std::vector<size_t> columns;
+    std::vector<DataType> types;
+    bool has_string = false;
+    size_t fixed_key_size = 0;
+    for (auto& path : column_paths) {
+        if (path.size() != 1) {
+            return util::none;
+        }
+        DataType type = table.get_column_type(path[0]);
+        switch (type) {
+            case type_Int:
+                fixed_key_size += 1 + sizeof(int64_t);
+                break;
+            case type_Bool:
+                fixed_key_size += 2;
+                break;
+            case type_Timestamp:
+                fixed_key_size += 1 + sizeof(int64_t) + sizeof(int32_t);
+                break;
+            case type_String:
+                has_string = true;
+                fixed_key_size += 1 + sizeof(size_t);
+                break;
+            default:
+                return util::none;
+        }
+        columns.push_back(path[0]);
+        types.push_back(type);
+    }
+    // Without strings the size of the keys is known, so a hash set which might not fit is not even started.
+    if (!has_string && view.size() > memory_limit / (fixed_key_size + entry_overhead)) {
+        return util::none;
+    }
+
+    std::unordered_set<std::string> keys;
+    std::vector<size_t> rows;
+    size_t used_memory = 0;
+    std::string key;
+    for (size_t i = 0; i < view.size(); ++i) {
+        if (!view.is_row_attached(i)) {
+            continue;
+        }
+        size_t row = view.get_source_ndx(i);
+        key.clear();
+        for (size_t j = 0; j < columns.size(); ++j) {
+            append_value(key, table, types[j], columns[j], row);
+        }
+        if (!keys.insert(key).second) {
+            continue;
+        }
+        used_memory += key.size() + entry_overhead;
+        if (used_memory > memory_limit) {
+            // Spills to Core's sort based distinct on the view already evaluated, without running the query again.
+            keys.clear();
+            view.distinct(std::move(descriptor));
+            return results_for_view(results.get_realm(), table, std::move(view));
+        }
+        rows.push_back(row);
+    }
+
+    DistinctTableView distinct_view(std::move(view), rows, std::move(descriptor));
+    return results_for_view(results.get_realm(), table, std::move(distinct_view));
+}
+
+size_t realm::_impl::get_hash_distinct_memory_limit() noexcept
+{
+    return s_memory_limit.load(std::memory_order_relaxed);
+}
+
+void realm::_impl::set_hash_distinct_memory_limit(size_t bytes) noexcept
+{
+    s_memory_limit.store(bytes, std::memory_order_relaxed);
+}
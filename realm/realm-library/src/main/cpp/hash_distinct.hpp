@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_HASH_DISTINCT_HPP
+#define REALM_JNI_IMPL_HASH_DISTINCT_HPP
+
+#include <vector>
+
+#include <realm/util/optional.hpp>
+#include <realm/views.hpp>
+
+#include <results.hpp>
+
+namespace realm {
+namespace _impl {
+
+// Distinct of Results by hashing the values of the distinct columns instead of sorting the rows.
+//
+// Core implements DistinctDescriptor by sorting the row indices on the distinct columns, which is O(n log(n)) and
+// compares every value several times. Since the distinct is the last descriptor applied to the Results, the order of
+// the view doesn't need to change, so the rows are scanned once in view order and the first row of every new key is
+// kept. That gives the same rows in the same order as Core would.
+//
+// Only Results which have been evaluated already are hashed, so the distinct doesn't force an evaluation. For any
+// other Results, or if a column path goes through a link or has a type which isn't supported (only integers,
+// booleans, strings and dates are), none is returned before anything is evaluated, and the caller is expected to use
+// Core's distinct, which stays lazy.
+//
+// The hash set grows with the number of distinct keys. Without string columns the size of a key is fixed, and none is
+// returned up front if the keys of all rows could need more than the memory limit. Otherwise, if the hash set grows
+// past the limit, Core's distinct is applied to the view which has been read, without running the query again.
+//
+// The returned Results is backed by a Query restricted to the distinct rows. The view restricting the query keeps the
+// DistinctDescriptor, so when it is synced after a change it is recomputed by Core and stays correct.
+util::Optional<Results> hash_distinct(Results& results, const std::vector<std::vector<size_t>>& column_paths,
+                                      DistinctDescriptor descriptor);
+
+// Memory limit in bytes of the hash set used by hash_distinct. 0 disables the hash based distinct.
+size_t get_hash_distinct_memory_limit() noexcept;
+void set_hash_distinct_memory_limit(size_t bytes) noexcept;
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_HASH_DISTINCT_HPP
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_realm_internal_NativeObjectStats.h"
+
+#include "native_object_stats.hpp"
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+#define REALM_CHECK_NATIVE_OBJECT_TYPE(type, java_type)                                                              \
+    static_assert(static_cast<int>(NativeObjectStats::Type::type) == io_realm_internal_NativeObjectStats_##java_type, \
+                  "NativeObjectStats::Type::" #type " doesn't match NativeObjectStats." #java_type)
+
+REALM_CHECK_NATIVE_OBJECT_TYPE(Row, TYPE_ROW);
+REALM_CHECK_NATIVE_OBJECT_TYPE(TableView, TYPE_TABLE_VIEW);
+REALM_CHECK_NATIVE_OBJECT_TYPE(Results, TYPE_RESULTS);
+REALM_CHECK_NATIVE_OBJECT_TYPE(List, TYPE_LIST);
+REALM_CHECK_NATIVE_OBJECT_TYPE(Object, TYPE_OBJECT);
+REALM_CHECK_NATIVE_OBJECT_TYPE(CollectionChangeSet, TYPE_COLLECTION_CHANGE_SET);
+REALM_CHECK_NATIVE_OBJECT_TYPE(ObjectBuilder, TYPE_OBJECT_BUILDER);
+REALM_CHECK_NATIVE_OBJECT_TYPE(DescriptorOrdering, TYPE_DESCRIPTOR_ORDERING);
+REALM_CHECK_NATIVE_OBJECT_TYPE(NumTypes, NUM_TYPES);
+
+#undef REALM_CHECK_NATIVE_OBJECT_TYPE
+
+NativeObjectStats::Counter* NativeObjectStats::counters() noexcept
+{
+    // Zero initialized before any dynamic initialization happens, so it is safe to be used by static objects.
+    static Counter s_counters[num_types];
+    return s_counters;
+}
+
+JNIEXPORT jlongArray JNICALL Java_io_realm_internal_NativeObjectStats_nativeGetStats(JNIEnv* env, jclass)
+{
+    TR_ENTER()
+    try {
+        // Returns {live_count_0, live_bytes_0, live_count_1, live_bytes_1, ...}
+        jlong stats[NativeObjectStats::num_types * 2];
+        for (size_t i = 0; i < NativeObjectStats::num_types; ++i) {
+            auto type = static_cast<NativeObjectStats::Type>(i);
+            stats[i * 2] = static_cast<jlong>(NativeObjectStats::live_count(type));
+            stats[i * 2 + 1] = static_cast<jlong>(NativeObjectStats::live_bytes(type));
+        }
+
+        jsize length = static_cast<jsize>(NativeObjectStats::num_types * 2);
+        jlongArray stats_array = env->NewLongArray(length);
+        if (!stats_array) {
+            ThrowException(env, OutOfMemory, "Could not allocate memory to return the native object stats.");
+            return nullptr;
+        }
+        env->SetLongArrayRegion(stats_array, 0, length, stats);
+        return stats_array;
+    }
+    CATCH_STD()
+    return nullptr;
+}
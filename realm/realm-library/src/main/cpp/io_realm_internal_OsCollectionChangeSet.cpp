@@ -16,68 +16,49 @@
 
 #include "io_realm_internal_OsCollectionChangeSet.h"
 
+#include <memory>
+#include <vector>
+
 #include <collection_notifications.hpp>
+#include <impl/collection_change_builder.hpp>
 
+#include "native_object_stats.hpp"
 #include "util.hpp"
 
 using namespace realm;
+using namespace realm::_impl;
 
 static void finalize_changeset(jlong ptr);
-static jintArray index_set_to_jint_array(JNIEnv* env, const IndexSet& index_set);
-static jintArray index_set_to_indices_array(JNIEnv* env, const IndexSet& index_set);
+static size_t count_ranges(const IndexSet& index_set);
+static size_t encoded_length(const CollectionChangeSet& change_set);
 
 static void finalize_changeset(jlong ptr)
 {
     TR_ENTER_PTR(ptr);
-    delete reinterpret_cast<CollectionChangeSet*>(ptr);
+    auto change_set = reinterpret_cast<CollectionChangeSet*>(ptr);
+    NativeObjectStats::on_destroy(NativeObjectStats::Type::CollectionChangeSet, estimated_size(*change_set));
+    delete change_set;
 }
 
-static jintArray index_set_to_jint_array(JNIEnv* env, const IndexSet& index_set)
+static size_t count_ranges(const IndexSet& index_set)
 {
-    if (index_set.empty()) {
-        return env->NewIntArray(0);
-    }
-
-    std::vector<jint> ranges_vector;
-    for (auto& changes : index_set) {
-        ranges_vector.push_back(changes.first);
-        ranges_vector.push_back(changes.second - changes.first);
+    size_t count = 0;
+    for (auto& range : index_set) {
+        static_cast<void>(range);
+        ++count;
     }
-
-    if (ranges_vector.size() > io_realm_internal_OsCollectionChangeSet_MAX_ARRAY_LENGTH) {
-        std::ostringstream error_msg;
-        error_msg << "There are too many ranges changed in this change set. They cannot fit into an array."
-                  << " ranges_vector's size: " << ranges_vector.size()
-                  << " Java array's max size: " << io_realm_internal_OsCollectionChangeSet_MAX_ARRAY_LENGTH << ".";
-        ThrowException(env, IllegalState, error_msg.str());
-        return nullptr;
-    }
-    jintArray jint_array = env->NewIntArray(static_cast<jsize>(ranges_vector.size()));
-    env->SetIntArrayRegion(jint_array, 0, ranges_vector.size(), ranges_vector.data());
-    return jint_array;
+    return count;
 }
 
-static jintArray index_set_to_indices_array(JNIEnv* env, const IndexSet& index_set)
+// Number of jints of the encoded change set. The layout must be kept in sync with OsCollectionChangeSet.java:
+// [deletion ranges count, insertion ranges count, modification ranges count, moves count,
+//  (start, length) of every deletion range, (start, length) of every insertion range,
+//  (start, length) of every modification range in the new collection, (from, to) of every move]
+static size_t encoded_length(const CollectionChangeSet& change_set)
 {
-    if (index_set.empty()) {
-        return env->NewIntArray(0);
-    }
-
-    std::vector<jint> indices_vector;
-    for (auto index : index_set.as_indexes()) {
-        indices_vector.push_back(index);
-    }
-    if (indices_vector.size() > io_realm_internal_OsCollectionChangeSet_MAX_ARRAY_LENGTH) {
-        std::ostringstream error_msg;
-        error_msg << "There are too many indices in this change set. They cannot fit into an array."
-                  << " indices_vector's size: " << indices_vector.size()
-                  << " Java array's max size: " << io_realm_internal_OsCollectionChangeSet_MAX_ARRAY_LENGTH << ".";
-        ThrowException(env, IllegalState, error_msg.str());
-        return nullptr;
-    }
-    jintArray jint_array = env->NewIntArray(static_cast<jsize>(indices_vector.size()));
-    env->SetIntArrayRegion(jint_array, 0, indices_vector.size(), indices_vector.data());
-    return jint_array;
+    return io_realm_internal_OsCollectionChangeSet_ENCODED_HEADER_LENGTH +
+           2 * (count_ranges(change_set.deletions) + count_ranges(change_set.insertions) +
+                count_ranges(change_set.modifications_new) + change_set.moves.size());
 }
 
 JNIEXPORT jlong JNICALL Java_io_realm_internal_OsCollectionChangeSet_nativeGetFinalizerPtr(JNIEnv*, jclass)
@@ -86,38 +67,71 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsCollectionChangeSet_nativeGetFi
     return reinterpret_cast<jlong>(&finalize_changeset);
 }
 
-JNIEXPORT jintArray JNICALL Java_io_realm_internal_OsCollectionChangeSet_nativeGetRanges(JNIEnv* env, jclass,
-                                                                                         jlong native_ptr, jint type)
+JNIEXPORT jintArray JNICALL Java_io_realm_internal_OsCollectionChangeSet_nativeEncode(JNIEnv* env, jclass,
+                                                                                      jlong native_ptr)
 {
     TR_ENTER_PTR(native_ptr)
-    // no throws
-    auto& change_set = *reinterpret_cast<CollectionChangeSet*>(native_ptr);
-    switch (type) {
-        case io_realm_internal_OsCollectionChangeSet_TYPE_DELETION:
-            return index_set_to_jint_array(env, change_set.deletions);
-        case io_realm_internal_OsCollectionChangeSet_TYPE_INSERTION:
-            return index_set_to_jint_array(env, change_set.insertions);
-        case io_realm_internal_OsCollectionChangeSet_TYPE_MODIFICATION:
-            return index_set_to_jint_array(env, change_set.modifications_new);
-        default:
-            REALM_UNREACHABLE();
+    try {
+        auto& change_set = *reinterpret_cast<CollectionChangeSet*>(native_ptr);
+        size_t length = encoded_length(change_set);
+        if (length > io_realm_internal_OsCollectionChangeSet_MAX_ARRAY_LENGTH) {
+            throw std::logic_error(util::format(
+                "There are too many ranges changed in this change set. %1 ints cannot fit into an array.", length));
+        }
+
+        std::vector<jint> data;
+        data.reserve(length);
+        data.push_back(static_cast<jint>(count_ranges(change_set.deletions)));
+        data.push_back(static_cast<jint>(count_ranges(change_set.insertions)));
+        data.push_back(static_cast<jint>(count_ranges(change_set.modifications_new)));
+        data.push_back(static_cast<jint>(change_set.moves.size()));
+        for (auto index_set : {&change_set.deletions, &change_set.insertions, &change_set.modifications_new}) {
+            for (auto& range : *index_set) {
+                data.push_back(static_cast<jint>(range.first));
+                data.push_back(static_cast<jint>(range.second - range.first));
+            }
+        }
+        for (auto& move : change_set.moves) {
+            data.push_back(static_cast<jint>(move.from));
+            data.push_back(static_cast<jint>(move.to));
+        }
+        REALM_ASSERT_DEBUG(data.size() == length);
+
+        jsize array_length = static_cast<jsize>(length);
+        jintArray j_data = env->NewIntArray(array_length);
+        if (!j_data) {
+            ThrowException(env, OutOfMemory, "Could not allocate memory to encode the change set.");
+            return nullptr;
+        }
+        env->SetIntArrayRegion(j_data, 0, array_length, data.data());
+        return j_data;
     }
+    CATCH_STD()
+    return nullptr;
 }
 
-JNIEXPORT jintArray JNICALL Java_io_realm_internal_OsCollectionChangeSet_nativeGetIndices(JNIEnv* env, jclass,
-                                                                                          jlong native_ptr, jint type)
+JNIEXPORT jlong JNICALL Java_io_realm_internal_OsCollectionChangeSet_nativeCoalesce(JNIEnv* env, jclass,
+                                                                                    jlong earlier_ptr,
+                                                                                    jlong later_ptr)
 {
-    TR_ENTER_PTR(native_ptr)
-    // no throws
-    auto& change_set = *reinterpret_cast<CollectionChangeSet*>(native_ptr);
-    switch (type) {
-        case io_realm_internal_OsCollectionChangeSet_TYPE_DELETION:
-            return index_set_to_indices_array(env, change_set.deletions);
-        case io_realm_internal_OsCollectionChangeSet_TYPE_INSERTION:
-            return index_set_to_indices_array(env, change_set.insertions);
-        case io_realm_internal_OsCollectionChangeSet_TYPE_MODIFICATION:
-            return index_set_to_indices_array(env, change_set.modifications_new);
-        default:
-            REALM_UNREACHABLE();
+    TR_ENTER_PTR(earlier_ptr)
+    // Both change sets are owned by this call from here on, they are freed even if merging them fails.
+    auto free_change_set = [](CollectionChangeSet* change_set) {
+        finalize_changeset(reinterpret_cast<jlong>(change_set));
+    };
+    std::unique_ptr<CollectionChangeSet, decltype(free_change_set)> earlier(
+        reinterpret_cast<CollectionChangeSet*>(earlier_ptr), free_change_set);
+    std::unique_ptr<CollectionChangeSet, decltype(free_change_set)> later(
+        reinterpret_cast<CollectionChangeSet*>(later_ptr), free_change_set);
+    try {
+        // The builder expects the modifications in the new collection, their indices in the old collection are
+        // computed again when it is finalized.
+        CollectionChangeBuilder builder(earlier->deletions, earlier->insertions, earlier->modifications_new,
+                                        earlier->moves);
+        builder.merge(
+            CollectionChangeBuilder(later->deletions, later->insertions, later->modifications_new, later->moves));
+        return reinterpret_cast<jlong>(new_tracked_change_set(std::move(builder).finalize()));
     }
+    CATCH_STD()
+    return 0;
 }
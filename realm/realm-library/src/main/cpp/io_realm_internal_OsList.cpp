@@ -16,13 +16,20 @@
 
 #include "io_realm_internal_OsList.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 #include <list.hpp>
+#include <object_store.hpp>
 #include <results.hpp>
 #include <shared_realm.hpp>
 
 #include "observable_collection_wrapper.hpp"
 #include "java_accessor.hpp"
 #include "java_exception_def.hpp"
+#include "java_query_descriptor.hpp"
+#include "native_object_stats.hpp"
 #include "jni_util/java_exception_thrower.hpp"
 #include "util.hpp"
 
@@ -37,6 +44,7 @@ void finalize_list(jlong ptr)
 {
     TR_ENTER_PTR(ptr)
     delete reinterpret_cast<ListWrapper*>(ptr);
+    NativeObjectStats::on_destroy(NativeObjectStats::Type::List, sizeof(ListWrapper));
 }
 
 inline void add_value(JNIEnv* env, jlong list_ptr, Any&& value)
@@ -72,6 +80,320 @@ inline void check_nullable(JNIEnv* env, jlong list_ptr, jobject jobject_ptr = nu
                              "This 'RealmList' is not nullable. A non-null value is expected.");
     }
 }
+
+void check_list_type(JNIEnv* env, List& list, PropertyType type)
+{
+    PropertyType list_type = list.get_type() & ~PropertyType::Flags;
+    if (list_type != type) {
+        THROW_JAVA_EXCEPTION(env, JavaExceptionDef::IllegalArgument,
+                             util::format("This 'RealmList' holds '%1' values, not '%2' values.",
+                                          string_for_property_type(list_type), string_for_property_type(type)));
+    }
+}
+
+void check_list_range(List& list, size_t pos, size_t count)
+{
+    if (count > 0 && pos + count > list.size()) {
+        throw List::OutOfBoundsIndexException{pos + count - 1, list.size()};
+    }
+}
+
+// The bulk writes below call the typed List::add()/set() directly instead of boxing every element into an Any, and
+// everything which could fail is checked once before the first element is written. A pos of npos appends the values.
+void check_bulk_write(JNIEnv* env, List& list, PropertyType type, size_t pos, size_t count, bool has_null)
+{
+    check_list_type(env, list, type);
+    if (has_null && !is_nullable(list.get_type())) {
+        THROW_JAVA_EXCEPTION(env, JavaExceptionDef::IllegalArgument,
+                             "This 'RealmList' is not nullable. A non-null value is expected.");
+    }
+    if (pos != npos) {
+        check_list_range(list, pos, count);
+    }
+}
+
+template <typename T>
+inline void write_value(List& list, size_t pos, size_t i, T value)
+{
+    if (pos == npos) {
+        list.add(value);
+    }
+    else {
+        list.set(pos + i, value);
+    }
+}
+
+inline size_t to_bulk_pos(jlong pos)
+{
+    if (pos < 0) {
+        throw std::invalid_argument(util::format("Invalid list index: %1.", pos));
+    }
+    return static_cast<size_t>(pos);
+}
+
+// Reads the optional null mask of a bulk write. Returns true if any of the values is null.
+bool read_null_mask(const JBooleanArrayAccessor& nulls, jsize count)
+{
+    if (nulls.data() == nullptr) {
+        return false;
+    }
+    if (nulls.size() != count) {
+        throw std::invalid_argument(
+            util::format("The null mask has %1 elements, but %2 values are given.", nulls.size(), count));
+    }
+    return std::find(nulls.data(), nulls.data() + count, JNI_TRUE) != nulls.data() + count;
+}
+
+// Writes the elements of a long[], float[], double[] or boolean[] as T. Nullable lists are written with
+// util::Optional<T> as the List accessors expect.
+template <typename T, typename Accessor>
+void write_all(JNIEnv* env, jlong list_ptr, PropertyType type, size_t pos, const Accessor& values,
+               jbooleanArray j_nulls)
+{
+    auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+    JBooleanArrayAccessor nulls(env, j_nulls);
+    auto count = static_cast<size_t>(values.size());
+    bool has_null = read_null_mask(nulls, values.size());
+    check_bulk_write(env, list, type, pos, count, has_null);
+
+    if (is_nullable(list.get_type())) {
+        for (size_t i = 0; i < count; ++i) {
+            bool is_null = has_null && nulls[i] == JNI_TRUE;
+            write_value(list, pos, i, is_null ? util::Optional<T>() : util::Optional<T>(static_cast<T>(values[i])));
+        }
+    }
+    else {
+        for (size_t i = 0; i < count; ++i) {
+            write_value(list, pos, i, static_cast<T>(values[i]));
+        }
+    }
+}
+
+void write_all_dates(JNIEnv* env, jlong list_ptr, size_t pos, jlongArray j_values, jbooleanArray j_nulls)
+{
+    auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+    JLongArrayAccessor values(env, j_values);
+    JBooleanArrayAccessor nulls(env, j_nulls);
+    auto count = static_cast<size_t>(values.size());
+    bool has_null = read_null_mask(nulls, values.size());
+    check_bulk_write(env, list, PropertyType::Date, pos, count, has_null);
+
+    for (size_t i = 0; i < count; ++i) {
+        bool is_null = has_null && nulls[i] == JNI_TRUE;
+        write_value(list, pos, i, is_null ? Timestamp() : from_milliseconds(values[i]));
+    }
+}
+
+void write_all_strings(JNIEnv* env, jlong list_ptr, size_t pos, jobjectArray j_values)
+{
+    auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+    jsize count = j_values ? env->GetArrayLength(j_values) : 0;
+    // The accessors own the converted strings, the StringData only point to them.
+    std::vector<JStringAccessor> accessors;
+    std::vector<StringData> values;
+    accessors.reserve(count);
+    values.reserve(count);
+    bool has_null = false;
+    for (jsize i = 0; i < count; ++i) {
+        auto j_value = static_cast<jstring>(env->GetObjectArrayElement(j_values, i));
+        has_null = has_null || !j_value;
+        accessors.emplace_back(env, j_value);
+        env->DeleteLocalRef(j_value);
+        values.push_back(accessors.back());
+    }
+    check_bulk_write(env, list, PropertyType::String, pos, values.size(), has_null);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        write_value(list, pos, i, values[i]);
+    }
+}
+
+void write_all_binaries(JNIEnv* env, jlong list_ptr, size_t pos, jobjectArray j_values)
+{
+    auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+    jsize count = j_values ? env->GetArrayLength(j_values) : 0;
+    std::vector<OwnedBinaryData> values;
+    values.reserve(count);
+    bool has_null = false;
+    for (jsize i = 0; i < count; ++i) {
+        auto j_value = static_cast<jbyteArray>(env->GetObjectArrayElement(j_values, i));
+        has_null = has_null || !j_value;
+        values.push_back(to_owned_binary_data(env, j_value));
+        env->DeleteLocalRef(j_value);
+    }
+    check_bulk_write(env, list, PropertyType::Data, pos, values.size(), has_null);
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        write_value(list, pos, i, values[i].get());
+    }
+}
+
+void write_all_rows(JNIEnv* env, jlong list_ptr, size_t pos, jlongArray j_target_row_indices)
+{
+    auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+    JLongArrayAccessor target_row_indices(env, j_target_row_indices);
+    auto count = static_cast<size_t>(target_row_indices.size());
+    check_bulk_write(env, list, PropertyType::Object, pos, count, false);
+    // All indices are checked before the first one is written, so an invalid one leaves the list unchanged.
+    auto target_table = ObjectStore::table_for_object_type(list.get_realm()->read_group(),
+                                                           list.get_object_schema().name);
+    auto target_size = static_cast<jlong>(target_table->size());
+    auto end = target_row_indices.data() + target_row_indices.size();
+    auto invalid = std::find_if(target_row_indices.data(), end,
+                                [target_size](jlong index) { return index < 0 || index >= target_size; });
+    if (invalid != end) {
+        throw std::invalid_argument(
+            util::format("Invalid row index %1, the target table has %2 rows.", *invalid, target_size));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        write_value(list, pos, i, static_cast<size_t>(target_row_indices[i]));
+    }
+}
+
+// The bulk reads below copy a range of the list into a Java array with a single Set<Type>ArrayRegion call. Null
+// values are read as 0 and flagged in the optional null mask.
+inline void set_array_region(JNIEnv* env, jlongArray array, jsize size, const jlong* buf)
+{
+    env->SetLongArrayRegion(array, 0, size, buf);
+}
+
+inline void set_array_region(JNIEnv* env, jdoubleArray array, jsize size, const jdouble* buf)
+{
+    env->SetDoubleArrayRegion(array, 0, size, buf);
+}
+
+inline void set_array_region(JNIEnv* env, jfloatArray array, jsize size, const jfloat* buf)
+{
+    env->SetFloatArrayRegion(array, 0, size, buf);
+}
+
+inline void set_array_region(JNIEnv* env, jbooleanArray array, jsize size, const jboolean* buf)
+{
+    env->SetBooleanArrayRegion(array, 0, size, buf);
+}
+
+// Checks the type and the range of a bulk read and returns the number of elements to read.
+jsize check_bulk_read(JNIEnv* env, List& list, PropertyType type, size_t start, jarray j_values, jbooleanArray j_nulls)
+{
+    check_list_type(env, list, type);
+    jsize count = env->GetArrayLength(j_values);
+    if (j_nulls && env->GetArrayLength(j_nulls) != count) {
+        throw std::invalid_argument(util::format("The null mask has %1 elements, but %2 values are requested.",
+                                                 env->GetArrayLength(j_nulls), count));
+    }
+    check_list_range(list, start, static_cast<size_t>(count));
+    return count;
+}
+
+// Reads the elements of the list as T into a long[], float[], double[] or boolean[] of the JNI type J.
+template <typename T, typename J, typename ArrayType>
+void read_all(JNIEnv* env, jlong list_ptr, PropertyType type, size_t start, ArrayType j_values, jbooleanArray j_nulls)
+{
+    auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+    jsize count = check_bulk_read(env, list, type, start, j_values, j_nulls);
+    std::vector<J> values(count);
+    std::vector<jboolean> nulls(j_nulls ? count : 0, JNI_FALSE);
+
+    if (is_nullable(list.get_type())) {
+        for (jsize i = 0; i < count; ++i) {
+            auto value = list.get<util::Optional<T>>(start + i);
+            if (value) {
+                values[i] = static_cast<J>(*value);
+            }
+            else if (j_nulls) {
+                nulls[i] = JNI_TRUE;
+            }
+        }
+    }
+    else {
+        for (jsize i = 0; i < count; ++i) {
+            values[i] = static_cast<J>(list.get<T>(start + i));
+        }
+    }
+    set_array_region(env, j_values, count, values.data());
+    if (j_nulls) {
+        set_array_region(env, j_nulls, count, nulls.data());
+    }
+}
+
+void read_all_timestamps(JNIEnv* env, jlong list_ptr, size_t start, jlongArray j_values, jbooleanArray j_nulls)
+{
+    auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+    jsize count = check_bulk_read(env, list, PropertyType::Date, start, j_values, j_nulls);
+    std::vector<jlong> values(count);
+    std::vector<jboolean> nulls(j_nulls ? count : 0, JNI_FALSE);
+
+    for (jsize i = 0; i < count; ++i) {
+        auto value = list.get<Timestamp>(start + i);
+        if (!value.is_null()) {
+            values[i] = to_milliseconds(value);
+        }
+        else if (j_nulls) {
+            nulls[i] = JNI_TRUE;
+        }
+    }
+    set_array_region(env, j_values, count, values.data());
+    if (j_nulls) {
+        set_array_region(env, j_nulls, count, nulls.data());
+    }
+}
+
+// Reorders the list so that the element at new_order[i] ends up at position i. Every swap puts one element in its
+// final position, so at most size - 1 swaps are needed instead of the O(n^2) element shifts a sequence of moves costs.
+// All swaps happen in the same write transaction, so listeners get a single change set.
+void apply_permutation(List& list, const std::vector<size_t>& new_order)
+{
+    size_t size = new_order.size();
+    // original_at[i] is the original position of the element now at i, position_of is its inverse.
+    std::vector<size_t> original_at(size);
+    std::vector<size_t> position_of(size);
+    for (size_t i = 0; i < size; ++i) {
+        original_at[i] = i;
+        position_of[i] = i;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        size_t from = position_of[new_order[i]];
+        if (from == i) {
+            continue;
+        }
+        list.swap(i, from);
+        size_t displaced = original_at[i];
+        original_at[from] = displaced;
+        position_of[displaced] = from;
+        original_at[i] = new_order[i];
+        position_of[new_order[i]] = i;
+    }
+}
+
+// Turns a sorted Results of the list into a permutation of the list positions and applies it. Object lists can hold
+// the same object several times, so the positions of every target row are handed out in list order which keeps the
+// sort stable.
+void apply_sorted_order(List& list, Results& sorted)
+{
+    size_t size = list.size();
+    std::vector<size_t> new_order;
+    new_order.reserve(size);
+    if ((list.get_type() & ~PropertyType::Flags) == PropertyType::Object) {
+        std::unordered_map<size_t, std::vector<size_t>> positions;
+        for (size_t i = size; i > 0; --i) {
+            positions[list.get(i - 1).get_index()].push_back(i - 1);
+        }
+        for (size_t i = 0; i < size; ++i) {
+            auto& target_positions = positions[sorted.get(i).get_index()];
+            new_order.push_back(target_positions.back());
+            target_positions.pop_back();
+        }
+    }
+    else {
+        // The values of a primitive list are the rows of its sub table, the row index is the list position.
+        for (size_t i = 0; i < size; ++i) {
+            new_order.push_back(sorted.get(i).get_index());
+        }
+    }
+    apply_permutation(list, new_order);
+}
 } // anonymous namespace
 
 JNIEXPORT jlong JNICALL Java_io_realm_internal_OsList_nativeGetFinalizerPtr(JNIEnv*, jclass)
@@ -97,6 +419,7 @@ JNIEXPORT jlongArray JNICALL Java_io_realm_internal_OsList_nativeCreate(JNIEnv*
 
         List list(shared_realm, *row.get_table(), column_index, row.get_index());
         ListWrapper* wrapper_ptr = new ListWrapper(list);
+        NativeObjectStats::on_create(NativeObjectStats::Type::List, sizeof(ListWrapper));
         ret[0] = reinterpret_cast<jlong>(wrapper_ptr);
 
         if (wrapper_ptr->collection().get_type() == PropertyType::Object) {
@@ -130,7 +453,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsList_nativeGetRow(JNIEnv* env,
     try {
         auto& wrapper = *reinterpret_cast<ListWrapper*>(list_ptr);
         auto row = wrapper.collection().get(column_index);
-        return reinterpret_cast<jlong>(new Row(std::move(row)));
+        return reinterpret_cast<jlong>(new_tracked_row(std::move(row)));
     }
     CATCH_STD()
     return reinterpret_cast<jlong>(nullptr);
@@ -265,6 +588,22 @@ JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeDeleteAll(JNIEnv* env
     CATCH_STD()
 }
 
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetKeyPathFilter(JNIEnv* env, jclass, jlong native_ptr,
+                                                                            jlongArray j_columns)
+{
+    TR_ENTER_PTR(native_ptr)
+    try {
+        auto wrapper = reinterpret_cast<ListWrapper*>(native_ptr);
+        JLongArrayRegion columns(env, j_columns);
+        std::vector<size_t> filter;
+        for (jsize i = 0; i < columns.size(); ++i) {
+            filter.push_back(static_cast<size_t>(columns[i]));
+        }
+        wrapper->set_key_path_filter(std::move(filter));
+    }
+    CATCH_STD()
+}
+
 JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeStartListening(JNIEnv* env, jobject instance,
                                                                               jlong native_ptr)
 {
@@ -549,3 +888,319 @@ JNIEXPORT jobject JNICALL Java_io_realm_internal_OsList_nativeGetValue(JNIEnv* e
 
     return nullptr;
 }
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeAddAllLongs(JNIEnv* env, jclass, jlong list_ptr,
+                                                                       jlongArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        JLongArrayAccessor values(env, j_values);
+        write_all<int64_t>(env, list_ptr, PropertyType::Int, npos, values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetRangeLongs(JNIEnv* env, jclass, jlong list_ptr, jlong pos,
+                                                                         jlongArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        JLongArrayAccessor values(env, j_values);
+        write_all<int64_t>(env, list_ptr, PropertyType::Int, to_bulk_pos(pos), values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeAddAllDoubles(JNIEnv* env, jclass, jlong list_ptr,
+                                                                         jdoubleArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        JDoubleArrayAccessor values(env, j_values);
+        write_all<double>(env, list_ptr, PropertyType::Double, npos, values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetRangeDoubles(JNIEnv* env, jclass, jlong list_ptr,
+                                                                           jlong pos, jdoubleArray j_values,
+                                                                           jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        JDoubleArrayAccessor values(env, j_values);
+        write_all<double>(env, list_ptr, PropertyType::Double, to_bulk_pos(pos), values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeAddAllFloats(JNIEnv* env, jclass, jlong list_ptr,
+                                                                        jfloatArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        JFloatArrayAccessor values(env, j_values);
+        write_all<float>(env, list_ptr, PropertyType::Float, npos, values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetRangeFloats(JNIEnv* env, jclass, jlong list_ptr,
+                                                                          jlong pos, jfloatArray j_values,
+                                                                          jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        JFloatArrayAccessor values(env, j_values);
+        write_all<float>(env, list_ptr, PropertyType::Float, to_bulk_pos(pos), values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeAddAllBooleans(JNIEnv* env, jclass, jlong list_ptr,
+                                                                          jbooleanArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        JBooleanArrayAccessor values(env, j_values);
+        write_all<bool>(env, list_ptr, PropertyType::Bool, npos, values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetRangeBooleans(JNIEnv* env, jclass, jlong list_ptr,
+                                                                            jlong pos, jbooleanArray j_values,
+                                                                            jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        JBooleanArrayAccessor values(env, j_values);
+        write_all<bool>(env, list_ptr, PropertyType::Bool, to_bulk_pos(pos), values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeAddAllDates(JNIEnv* env, jclass, jlong list_ptr,
+                                                                       jlongArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        write_all_dates(env, list_ptr, npos, j_values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetRangeDates(JNIEnv* env, jclass, jlong list_ptr, jlong pos,
+                                                                         jlongArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        write_all_dates(env, list_ptr, to_bulk_pos(pos), j_values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeAddAllStrings(JNIEnv* env, jclass, jlong list_ptr,
+                                                                         jobjectArray j_values)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        write_all_strings(env, list_ptr, npos, j_values);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetRangeStrings(JNIEnv* env, jclass, jlong list_ptr,
+                                                                           jlong pos, jobjectArray j_values)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        write_all_strings(env, list_ptr, to_bulk_pos(pos), j_values);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeAddAllBinaries(JNIEnv* env, jclass, jlong list_ptr,
+                                                                          jobjectArray j_values)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        write_all_binaries(env, list_ptr, npos, j_values);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetRangeBinaries(JNIEnv* env, jclass, jlong list_ptr,
+                                                                            jlong pos, jobjectArray j_values)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        write_all_binaries(env, list_ptr, to_bulk_pos(pos), j_values);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeAddAllRows(JNIEnv* env, jclass, jlong list_ptr,
+                                                                      jlongArray j_target_row_indices)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        write_all_rows(env, list_ptr, npos, j_target_row_indices);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSetRangeRows(JNIEnv* env, jclass, jlong list_ptr, jlong pos,
+                                                                        jlongArray j_target_row_indices)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        write_all_rows(env, list_ptr, to_bulk_pos(pos), j_target_row_indices);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeGetLongs(JNIEnv* env, jclass, jlong list_ptr, jlong start,
+                                                                    jlongArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        read_all<int64_t, jlong>(env, list_ptr, PropertyType::Int, to_bulk_pos(start), j_values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeGetDoubles(JNIEnv* env, jclass, jlong list_ptr, jlong start,
+                                                                      jdoubleArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        read_all<double, jdouble>(env, list_ptr, PropertyType::Double, to_bulk_pos(start), j_values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeGetFloats(JNIEnv* env, jclass, jlong list_ptr, jlong start,
+                                                                     jfloatArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        read_all<float, jfloat>(env, list_ptr, PropertyType::Float, to_bulk_pos(start), j_values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeGetBooleans(JNIEnv* env, jclass, jlong list_ptr, jlong start,
+                                                                       jbooleanArray j_values, jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        read_all<bool, jboolean>(env, list_ptr, PropertyType::Bool, to_bulk_pos(start), j_values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeGetTimestamps(JNIEnv* env, jclass, jlong list_ptr,
+                                                                         jlong start, jlongArray j_values,
+                                                                         jbooleanArray j_nulls)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        read_all_timestamps(env, list_ptr, to_bulk_pos(start), j_values, j_nulls);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeGetStrings(JNIEnv* env, jclass, jlong list_ptr, jlong start,
+                                                                      jobjectArray j_values)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+        size_t pos = to_bulk_pos(start);
+        jsize count = check_bulk_read(env, list, PropertyType::String, pos, j_values, nullptr);
+        for (jsize i = 0; i < count; ++i) {
+            jstring j_value = to_jstring(env, list.get<StringData>(pos + i));
+            env->SetObjectArrayElement(j_values, i, j_value);
+            env->DeleteLocalRef(j_value);
+        }
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeGetRowIndices(JNIEnv* env, jclass, jlong list_ptr,
+                                                                         jlong start, jlongArray j_target_row_indices)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+        size_t pos = to_bulk_pos(start);
+        jsize count = check_bulk_read(env, list, PropertyType::Object, pos, j_target_row_indices, nullptr);
+        std::vector<jlong> target_row_indices(count);
+        for (jsize i = 0; i < count; ++i) {
+            target_row_indices[i] = static_cast<jlong>(list.get(pos + i).get_index());
+        }
+        set_array_region(env, j_target_row_indices, count, target_row_indices.data());
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeApplyPermutation(JNIEnv* env, jclass, jlong list_ptr,
+                                                                            jintArray j_new_order)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+        jsize size = env->GetArrayLength(j_new_order);
+        if (static_cast<size_t>(size) != list.size()) {
+            throw std::invalid_argument(
+                util::format("The new order has %1 elements, but the list has %2.", size, list.size()));
+        }
+        std::vector<jint> j_order(size);
+        env->GetIntArrayRegion(j_new_order, 0, size, j_order.data());
+
+        std::vector<size_t> new_order(size);
+        std::vector<bool> seen(size, false);
+        for (jsize i = 0; i < size; ++i) {
+            jint index = j_order[i];
+            if (index < 0 || index >= size || seen[index]) {
+                throw std::invalid_argument(
+                    util::format("The new order is not a permutation of the list positions: %1 at %2.", index, i));
+            }
+            seen[index] = true;
+            new_order[i] = static_cast<size_t>(index);
+        }
+        apply_permutation(list, new_order);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSortBy(JNIEnv* env, jclass, jlong list_ptr,
+                                                                  jobject j_sort_desc)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+        check_list_type(env, list, PropertyType::Object);
+        Results sorted = list.sort(JavaQueryDescriptor(env, j_sort_desc).sort_descriptor());
+        apply_sorted_order(list, sorted);
+    }
+    CATCH_STD()
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsList_nativeSortValues(JNIEnv* env, jclass, jlong list_ptr,
+                                                                      jboolean j_ascending)
+{
+    TR_ENTER_PTR(list_ptr)
+    try {
+        auto& list = reinterpret_cast<ListWrapper*>(list_ptr)->collection();
+        if ((list.get_type() & ~PropertyType::Flags) == PropertyType::Object) {
+            throw std::invalid_argument("Lists of objects must be sorted by a field.");
+        }
+        // Column 0 of the sub table holds the values.
+        TableRef table = list.get_query().get_table();
+        Results sorted = list.sort(SortDescriptor(*table, {{0}}, {j_ascending == JNI_TRUE}));
+        apply_sorted_order(list, sorted);
+    }
+    CATCH_STD()
+}
@@ -28,6 +28,7 @@
 
 #include "util.hpp"
 #include "java_class_global_def.hpp"
+#include "native_object_stats.hpp"
 
 #include "jni_util/java_global_weak_ref.hpp"
 #include "jni_util/java_method.hpp"
@@ -162,6 +163,7 @@ static void finalize_object(jlong ptr)
 {
     TR_ENTER_PTR(ptr);
     delete reinterpret_cast<ObjectWrapper*>(ptr);
+    NativeObjectStats::on_destroy(NativeObjectStats::Type::Object, sizeof(ObjectWrapper));
 }
 
 static inline size_t do_create_row(jlong shared_realm_ptr, jlong table_ptr)
@@ -278,6 +280,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsObject_nativeCreate(JNIEnv*, jc
     auto& row = *(reinterpret_cast<Row*>(row_ptr));
     Object object(shared_realm, dummy_object_schema, row); // no throw
     auto wrapper = new ObjectWrapper(object);              // no throw
+    NativeObjectStats::on_create(NativeObjectStats::Type::Object, sizeof(ObjectWrapper));
 
     return reinterpret_cast<jlong>(wrapper);
 }
@@ -331,7 +334,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsObject_nativeCreateNewObject(JN
     try {
         size_t row_ndx = do_create_row(shared_realm_ptr, table_ptr);
         auto& table = *(reinterpret_cast<realm::Table*>(table_ptr));
-        return reinterpret_cast<jlong>(new Row(table[row_ndx]));
+        return reinterpret_cast<jlong>(new_tracked_row(table[row_ndx]));
     }
     CATCH_STD()
     return 0;
@@ -346,7 +349,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsObject_nativeCreateNewObjectWit
         size_t row_ndx =
             do_create_row_with_primary_key(env, shared_realm_ptr, table_ptr, pk_column_ndx, pk_value, is_pk_null);
         if (row_ndx != realm::npos) {
-            return reinterpret_cast<jlong>(new Row(table[row_ndx]));
+            return reinterpret_cast<jlong>(new_tracked_row(table[row_ndx]));
         }
     }
     CATCH_STD()
@@ -371,7 +374,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsObject_nativeCreateNewObjectWit
         auto& table = *(reinterpret_cast<realm::Table*>(table_ptr));
         size_t row_ndx = do_create_row_with_primary_key(env, shared_realm_ptr, table_ptr, pk_column_ndx, pk_value);
         if (row_ndx != realm::npos) {
-            return reinterpret_cast<jlong>(new Row(table[row_ndx]));
+            return reinterpret_cast<jlong>(new_tracked_row(table[row_ndx]));
         }
     }
     CATCH_STD()
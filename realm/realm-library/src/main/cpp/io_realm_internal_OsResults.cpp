@@ -16,6 +16,8 @@
 
 #include "io_realm_internal_OsResults.h"
 
+#include <algorithm>
+
 #include <shared_realm.hpp>
 #include <results.hpp>
 #include <list.hpp>
@@ -23,7 +25,11 @@
 
 #include "java_class_global_def.hpp"
 #include "java_object_accessor.hpp"
+#include "java_object_batch.hpp"
+#include "java_object_data.hpp"
+#include "hash_distinct.hpp"
 #include "java_query_descriptor.hpp"
+#include "native_object_stats.hpp"
 #include "observable_collection_wrapper.hpp"
 #include "util.hpp"
 
@@ -39,6 +45,14 @@ static void finalize_results(jlong ptr)
 {
     TR_ENTER_PTR(ptr);
     delete reinterpret_cast<ResultsWrapper*>(ptr);
+    NativeObjectStats::on_destroy(NativeObjectStats::Type::Results, sizeof(ResultsWrapper));
+}
+
+static inline ResultsWrapper* new_results_wrapper(Results& results)
+{
+    auto wrapper = new ResultsWrapper(results);
+    NativeObjectStats::on_create(NativeObjectStats::Type::Results, sizeof(ResultsWrapper));
+    return wrapper;
 }
 
 JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeCreateResults(JNIEnv* env, jclass,
@@ -56,7 +70,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeCreateResults(JNI
         auto shared_realm = *(reinterpret_cast<SharedRealm*>(shared_realm_ptr));
         auto descriptor_ordering = *(reinterpret_cast<DescriptorOrdering*>(descriptor_ordering_ptr));
         Results results(shared_realm, *query, descriptor_ordering);
-        auto wrapper = new ResultsWrapper(results);
+        auto wrapper = new_results_wrapper(results);
 
         return reinterpret_cast<jlong>(wrapper);
     }
@@ -70,7 +84,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeCreateSnapshot(JN
     try {
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
         auto snapshot_results = wrapper->collection().snapshot();
-        auto snapshot_wrapper = new ResultsWrapper(snapshot_results);
+        auto snapshot_wrapper = new_results_wrapper(snapshot_results);
         return reinterpret_cast<jlong>(snapshot_wrapper);
     }
     CATCH_STD();
@@ -84,7 +98,7 @@ JNIEXPORT jboolean JNICALL Java_io_realm_internal_OsResults_nativeContains(JNIEn
     try {
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
         auto row = reinterpret_cast<Row*>(native_row_ptr);
-        size_t index = wrapper->collection().index_of(RowExpr(*row));
+        size_t index = wrapper->position_index().index_of(wrapper->collection(), *row);
         return to_jbool(index != not_found);
     }
     CATCH_STD();
@@ -98,7 +112,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeGetRow(JNIEnv* en
     try {
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
         auto row = wrapper->collection().get(static_cast<size_t>(index));
-        return reinterpret_cast<jlong>(new Row(std::move(row)));
+        return reinterpret_cast<jlong>(new_tracked_row(std::move(row)));
     }
     CATCH_STD()
     return reinterpret_cast<jlong>(nullptr);
@@ -111,7 +125,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeFirstRow(JNIEnv*
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
         auto optional_row = wrapper->collection().first();
         if (optional_row) {
-            return reinterpret_cast<jlong>(new Row(std::move(optional_row.value())));
+            return reinterpret_cast<jlong>(new_tracked_row(std::move(optional_row.value())));
         }
     }
     CATCH_STD()
@@ -125,7 +139,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeLastRow(JNIEnv* e
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
         auto optional_row = wrapper->collection().last();
         if (optional_row) {
-            return reinterpret_cast<jlong>(new Row(std::move(optional_row.value())));
+            return reinterpret_cast<jlong>(new_tracked_row(std::move(optional_row.value())));
         }
     }
     CATCH_STD()
@@ -215,7 +229,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeSort(JNIEnv* env,
     try {
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
         auto sorted_result = wrapper->collection().sort(JavaQueryDescriptor(env, j_sort_desc).sort_descriptor());
-        return reinterpret_cast<jlong>(new ResultsWrapper(sorted_result));
+        return reinterpret_cast<jlong>(new_results_wrapper(sorted_result));
     }
     CATCH_STD()
     return reinterpret_cast<jlong>(nullptr);
@@ -227,14 +241,42 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeDistinct(JNIEnv*
     TR_ENTER_PTR(native_ptr)
     try {
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
-        auto distinct_result =
-            wrapper->collection().distinct(JavaQueryDescriptor(env, j_distinct_desc).distinct_descriptor());
-        return reinterpret_cast<jlong>(new ResultsWrapper(distinct_result));
+        JavaQueryDescriptor descriptor(env, j_distinct_desc);
+        auto hashed_result = hash_distinct(wrapper->collection(), descriptor.get_column_indices(),
+                                           descriptor.distinct_descriptor());
+        if (hashed_result) {
+            return reinterpret_cast<jlong>(new_results_wrapper(*hashed_result));
+        }
+        // Results not evaluated yet, unsupported columns or too many distinct values: use Core's lazy distinct.
+        auto distinct_result = wrapper->collection().distinct(descriptor.distinct_descriptor());
+        return reinterpret_cast<jlong>(new_results_wrapper(distinct_result));
     }
     CATCH_STD()
     return reinterpret_cast<jlong>(nullptr);
 }
 
+JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeSetHashDistinctMemoryLimit(JNIEnv*, jclass, jlong bytes)
+{
+    TR_ENTER()
+    set_hash_distinct_memory_limit(static_cast<size_t>(bytes));
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeSetKeyPathFilter(JNIEnv* env, jclass, jlong native_ptr,
+                                                                               jlongArray j_columns)
+{
+    TR_ENTER_PTR(native_ptr)
+    try {
+        auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
+        JLongArrayRegion columns(env, j_columns);
+        std::vector<size_t> filter;
+        for (jsize i = 0; i < columns.size(); ++i) {
+            filter.push_back(static_cast<size_t>(columns[i]));
+        }
+        wrapper->set_key_path_filter(std::move(filter));
+    }
+    CATCH_STD()
+}
+
 JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeStartListening(JNIEnv* env, jobject instance,
                                                                               jlong native_ptr)
 {
@@ -269,10 +311,29 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeWhere(JNIEnv* env
     TR_ENTER_PTR(native_ptr)
     try {
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
+        auto& results = wrapper->collection();
+
+        // Without sort, distinct or limit the rows of the results are exactly the matches of its query. Chain the new
+        // predicates onto that query instead of evaluating the results, it will be run once when the new results are
+        // needed. The query is and-ed as a whole into a new one, so an or() at its end doesn't bind to the new
+        // predicates. and_query() only takes over the conditions, so a query restricted by a view, e.g. from an
+        // earlier where() on sorted or distinct results, has to be evaluated below instead.
+        auto mode = results.get_mode();
+        if ((mode == Results::Mode::Table || mode == Results::Mode::Query) &&
+            results.get_descriptor_ordering().is_empty()) {
+            Query results_query = results.get_query();
+            if (results_query.produces_results_in_table_order()) {
+                Query* query = new Query(results_query.get_table()->where());
+                query->and_query(std::move(results_query));
+                return reinterpret_cast<jlong>(query);
+            }
+        }
 
-        auto table_view = wrapper->collection().get_tableview();
-        Query* query =
-            new Query(table_view.get_parent(), std::unique_ptr<TableViewBase>(new TableView(std::move(table_view))));
+        // Otherwise the order or the subset of rows picked by the descriptors or the view must be kept, restrict the
+        // query to the evaluated rows.
+        auto table_view = results.get_tableview();
+        Query* query = new Query(table_view.get_parent(),
+                                 std::unique_ptr<TableViewBase>(new TrackedTableView(std::move(table_view))));
         return reinterpret_cast<jlong>(query);
     }
     CATCH_STD()
@@ -294,6 +355,18 @@ JNIEXPORT jstring JNICALL Java_io_realm_internal_OsResults_toJSON(JNIEnv* env, j
     return nullptr;
 }
 
+JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeSetPositionIndexEnabled(JNIEnv* env, jclass,
+                                                                                      jlong native_ptr,
+                                                                                      jboolean enabled)
+{
+    TR_ENTER_PTR(native_ptr)
+    try {
+        auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
+        wrapper->position_index().set_enabled(enabled == JNI_TRUE);
+    }
+    CATCH_STD()
+}
+
 JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeIndexOf(JNIEnv* env, jclass, jlong native_ptr,
                                                                         jlong row_native_ptr)
 {
@@ -302,7 +375,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeIndexOf(JNIEnv* e
         auto wrapper = reinterpret_cast<ResultsWrapper*>(native_ptr);
         auto row = reinterpret_cast<Row*>(row_native_ptr);
 
-        return static_cast<jlong>(wrapper->collection().index_of(RowExpr(*row)));
+        return static_cast<jlong>(wrapper->position_index().index_of(wrapper->collection(), *row));
     }
     CATCH_STD()
     return npos;
@@ -389,15 +462,16 @@ JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeSetString(JNIEnv*
 {
     TR_ENTER_PTR(native_ptr)
     JStringAccessor str(env, j_value);
-    JavaValue value = str.is_null() ? JavaValue() : JavaValue(std::string(str));
+    std::string string_value(str);
+    JavaValue value = str.is_null() ? JavaValue() : JavaValue(StringData(string_value));
     update_objects(env, native_ptr, j_field_name, value);
 }
 
 JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeSetBinary(JNIEnv* env, jclass, jlong native_ptr, jstring j_field_name, jbyteArray j_value)
 {
     TR_ENTER_PTR(native_ptr)
-    auto data = OwnedBinaryData(JByteArrayAccessor(env, j_value).transform<BinaryData>());
-    JavaValue value(data);
+    auto data = to_owned_binary_data(env, j_value);
+    JavaValue value(data.get());
     update_objects(env, native_ptr, j_field_name, value);
 }
 
@@ -420,9 +494,122 @@ JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeSetList(JNIEnv* en
     // OsObjectBuilder has been used to build up the list we want to insert. This means the
     // fake object described by the OsObjectBuilder only contains one property, namely the list we
     // want to insert and this list is assumed to be at index = 0.
-    std::vector<JavaValue> builder = *reinterpret_cast<std::vector<JavaValue>*>(builder_ptr);
-    REALM_ASSERT_DEBUG(builder.size() == 1);
-    update_objects(env, native_ptr, j_field_name, builder[0]);
+    auto& builder = *reinterpret_cast<JavaObjectData*>(builder_ptr);
+    REALM_ASSERT_DEBUG(builder.values().size() == 1);
+    update_objects(env, native_ptr, j_field_name, builder.values()[0]);
+}
+
+static void set_property_value(JavaContext& ctx, const SharedRealm& realm, Table& table, size_t row_ndx,
+                               const Property& property, const JavaValue& value)
+{
+    size_t col = property.table_column;
+    if (is_array(property.type)) {
+        List list(realm, table, col, row_ndx);
+        list.assign(ctx, value);
+        return;
+    }
+    PropertyType type = property.type & ~PropertyType::Flags;
+    if (!value.has_value()) {
+        if (type == PropertyType::Object) {
+            table.nullify_link(col, row_ndx);
+        }
+        else {
+            table.set_null(col, row_ndx);
+        }
+        return;
+    }
+    switch (type) {
+        case PropertyType::Int:
+            table.set_int(col, row_ndx, value.get_int());
+            break;
+        case PropertyType::Bool:
+            table.set_bool(col, row_ndx, value.get_boolean() == JNI_TRUE);
+            break;
+        case PropertyType::Float:
+            table.set_float(col, row_ndx, value.get_float());
+            break;
+        case PropertyType::Double:
+            table.set_double(col, row_ndx, value.get_double());
+            break;
+        case PropertyType::String:
+            table.set_string(col, row_ndx, value.get_string());
+            break;
+        case PropertyType::Data:
+            table.set_binary(col, row_ndx, value.get_binary());
+            break;
+        case PropertyType::Date:
+            table.set_timestamp(col, row_ndx, value.get_date());
+            break;
+        case PropertyType::Object: {
+            const RowExpr& link = *value.get_object();
+            if (!link.is_attached() || link.get_table() != table.get_link_target(col).get()) {
+                throw std::invalid_argument(
+                    util::format("Property '%1' can only be set to a managed '%2' object.", property.name,
+                                 property.object_type));
+            }
+            table.set_link(col, row_ndx, link.get_index());
+            break;
+        }
+        default:
+            throw std::invalid_argument(util::format("Property '%1' of type '%2' cannot be set.", property.name,
+                                                     string_for_property_type(property.type)));
+    }
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeSetMany(JNIEnv* env, jclass, jlong native_ptr,
+                                                                       jlongArray j_column_indices,
+                                                                       jlong builder_ptr)
+{
+    TR_ENTER_PTR(native_ptr)
+    try {
+        auto& results = reinterpret_cast<ResultsWrapper*>(native_ptr)->collection();
+        auto& builder = *reinterpret_cast<JavaObjectData*>(builder_ptr);
+        SharedRealm realm = results.get_realm();
+        realm->verify_in_write();
+        const ObjectSchema& object_schema = results.get_object_schema();
+
+        // Every property is resolved and every value checked once, before any object is touched.
+        JLongArrayRegion column_indices(env, j_column_indices);
+        std::vector<std::pair<const Property*, const JavaValue*>> assignments;
+        assignments.reserve(column_indices.size());
+        for (jsize i = 0; i < column_indices.size(); ++i) {
+            auto col = static_cast<size_t>(column_indices[i]);
+            auto property = std::find_if(
+                object_schema.persisted_properties.begin(), object_schema.persisted_properties.end(),
+                [col](const Property& p) { return p.table_column == col; });
+            if (property == object_schema.persisted_properties.end() || col >= builder.values().size()) {
+                throw std::invalid_argument(
+                    util::format("Column %1 cannot be found in class '%2'.", col, object_schema.name));
+            }
+            // Setting the same value on every object would duplicate it, and the Table setters used below don't
+            // check uniqueness. So primary keys are rejected, even in a migration.
+            if (property->is_primary) {
+                throw std::logic_error(util::format(
+                    "Primary key field '%1' cannot be set on all objects of the results.", property->name));
+            }
+            const JavaValue& value = builder.values()[col];
+            validate_property_value(object_schema, *property, value);
+            assignments.emplace_back(&*property, &value);
+        }
+
+        // A snapshot, so objects leaving the results because of the new values are still updated. All properties of
+        // an object are set before moving on to the next one.
+        Results snapshot = results.snapshot();
+        JavaContext ctx(env, realm, object_schema);
+        size_t size = snapshot.size();
+        for (size_t i = 0; i < size; ++i) {
+            RowExpr row = snapshot.get(i);
+            if (!row.is_attached()) {
+                continue;
+            }
+            Table& table = *row.get_table();
+            size_t row_ndx = row.get_index();
+            for (auto& assignment : assignments) {
+                set_property_value(ctx, realm, table, row_ndx, *assignment.first, *assignment.second);
+            }
+        }
+    }
+    CATCH_STD()
 }
 
 JNIEXPORT void JNICALL Java_io_realm_internal_OsResults_nativeDelete(JNIEnv* env, jclass, jlong native_ptr,
@@ -489,7 +676,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResults_nativeCreateResultsFrom
         TableView backlink_view = row->get_table()->get_backlink_view(row->get_index(), src_table, src_col_index);
         auto shared_realm = *(reinterpret_cast<SharedRealm*>(shared_realm_ptr));
         Results results(shared_realm, std::move(backlink_view));
-        auto wrapper = new ResultsWrapper(results);
+        auto wrapper = new_results_wrapper(results);
         return reinterpret_cast<jlong>(wrapper);
     }
     CATCH_STD()
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_realm_internal_OsResultsPager.h"
+
+#include <results.hpp>
+
+#include "java_query_descriptor.hpp"
+#include "observable_collection_wrapper.hpp"
+#include "results_pager.hpp"
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+typedef ObservableCollectionWrapper<Results> ResultsWrapper;
+
+static void finalize_pager(jlong ptr)
+{
+    TR_ENTER_PTR(ptr)
+    delete reinterpret_cast<ResultsPager*>(ptr);
+}
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResultsPager_nativeGetFinalizerPtr(JNIEnv*, jclass)
+{
+    TR_ENTER()
+    return reinterpret_cast<jlong>(&finalize_pager);
+}
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_OsResultsPager_nativeCreate(JNIEnv* env, jclass, jlong results_ptr,
+                                                                           jobject j_sort_desc, jlong offset,
+                                                                           jlong page_size)
+{
+    TR_ENTER_PTR(results_ptr)
+    try {
+        auto& results = reinterpret_cast<ResultsWrapper*>(results_ptr)->collection();
+        auto mode = results.get_mode();
+        if (mode != Results::Mode::Table && mode != Results::Mode::Query) {
+            throw std::invalid_argument("Only the results of a query can be paged.");
+        }
+        if (results.get_descriptor_ordering().will_apply_distinct()) {
+            throw std::invalid_argument("Results with distinct cannot be paged.");
+        }
+        if (results.get_descriptor_ordering().will_apply_limit()) {
+            throw std::invalid_argument("Results with a limit cannot be paged.");
+        }
+        if (offset < 0 || page_size <= 0) {
+            throw std::invalid_argument(util::format("Invalid offset %1 or page size %2.", offset, page_size));
+        }
+        Query query = results.get_query();
+
+        std::vector<ResultsPager::SortColumn> sort_columns;
+        if (j_sort_desc) {
+            JavaQueryDescriptor sort_desc(env, j_sort_desc);
+            if (sort_desc.get_table_ptr() != query.get_table().get()) {
+                throw std::invalid_argument("The sort order is not for the class of the results.");
+            }
+            auto column_indices = sort_desc.get_column_indices();
+            auto ascendings = sort_desc.get_ascendings();
+            for (size_t i = 0; i < column_indices.size(); ++i) {
+                if (column_indices[i].size() != 1) {
+                    throw std::invalid_argument("Pages can only be sorted by fields of the class of the results.");
+                }
+                bool ascending = i < ascendings.size() ? ascendings[i] : true;
+                sort_columns.push_back({column_indices[i][0], ascending});
+            }
+        }
+
+        auto pager = new ResultsPager(std::move(query), std::move(sort_columns), static_cast<size_t>(offset),
+                                      static_cast<size_t>(page_size));
+        return reinterpret_cast<jlong>(pager);
+    }
+    CATCH_STD()
+    return reinterpret_cast<jlong>(nullptr);
+}
+
+JNIEXPORT jlongArray JNICALL Java_io_realm_internal_OsResultsPager_nativeNextPage(JNIEnv* env, jclass,
+                                                                                  jlong native_ptr)
+{
+    TR_ENTER_PTR(native_ptr)
+    try {
+        auto& pager = *reinterpret_cast<ResultsPager*>(native_ptr);
+        std::vector<size_t> page = pager.next_page();
+
+        std::vector<jlong> row_indices(page.begin(), page.end());
+        jsize length = static_cast<jsize>(row_indices.size());
+        jlongArray j_row_indices = env->NewLongArray(length);
+        if (!j_row_indices) {
+            ThrowException(env, OutOfMemory, "Could not allocate memory to return the page.");
+            return nullptr;
+        }
+        env->SetLongArrayRegion(j_row_indices, 0, length, row_indices.data());
+        return j_row_indices;
+    }
+    CATCH_STD()
+    return nullptr;
+}
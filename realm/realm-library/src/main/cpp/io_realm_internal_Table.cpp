@@ -20,8 +20,10 @@
 #include "io_realm_internal_Property.h"
 #include "io_realm_internal_Table.h"
 
+#include "column_index_cache.hpp"
 #include "java_accessor.hpp"
 #include "java_exception_def.hpp"
+#include "native_object_stats.hpp"
 #include "shared_realm.hpp"
 #include "jni_util/java_exception_thrower.hpp"
 
@@ -568,8 +570,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_Table_nativeGetColumnIndex(JNIEnv
         return 0;
     }
     try {
-        JStringAccessor columnName2(env, columnName);                                     // throws
-        return to_jlong_or_not_found(TBL(nativeTablePtr)->get_column_index(columnName2)); // noexcept
+        return to_jlong_or_not_found(find_column_index(env, *TBL(nativeTablePtr), columnName)); // throws
     }
     CATCH_STD()
     return 0;
@@ -907,7 +908,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_Table_nativeGetRowPtr(JNIEnv* env
                                                                      jlong index)
 {
     try {
-        Row* row = new Row((*TBL(nativeTablePtr))[S(index)]);
+        Row* row = new_tracked_row((*TBL(nativeTablePtr))[S(index)]);
         return reinterpret_cast<jlong>(row);
     }
     CATCH_STD()
@@ -26,6 +26,7 @@
 
 #include "java_accessor.hpp"
 #include "java_class_global_def.hpp"
+#include "native_object_stats.hpp"
 #include "util.hpp"
 
 using namespace realm;
@@ -70,8 +71,8 @@ JNIEXPORT jstring JNICALL Java_io_realm_internal_TableQuery_nativeValidateQuery(
 // If the corresponding entry in tablesArray is anything other than a nullptr, the link is a backlink.
 // In that case, the tablesArray element is the pointer to the backlink source table and the
 // indicesArray entry is the source column index in the source table.
-static TableRef getTableForLinkQuery(jlong nativeQueryPtr, const JLongArrayAccessor& tablesArray,
-                                     const JLongArrayAccessor& indicesArray)
+static TableRef getTableForLinkQuery(jlong nativeQueryPtr, const JLongArrayRegion& tablesArray,
+                                     const JLongArrayRegion& indicesArray)
 {
     auto table_ref = reinterpret_cast<Query *>(nativeQueryPtr)->get_table();
     jsize link_element_count = indicesArray.size() - 1;
@@ -89,8 +90,8 @@ static TableRef getTableForLinkQuery(jlong nativeQueryPtr, const JLongArrayAcces
 }
 
 // Return TableRef point to original table or the link table
-static TableRef getTableByArray(jlong nativeQueryPtr, const JLongArrayAccessor& tablesArray,
-                                const JLongArrayAccessor& indicesArray)
+static TableRef getTableByArray(jlong nativeQueryPtr, const JLongArrayRegion& tablesArray,
+                                const JLongArrayRegion& indicesArray)
 {
     auto table_ref = reinterpret_cast<Query *>(nativeQueryPtr)->get_table();
     jsize link_element_count = indicesArray.size() - 1;
@@ -164,8 +165,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeEqual__J_3J_3JJ(J
                                                                             jlongArray columnIndexes,
                                                                             jlongArray tablePointers, jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -188,8 +189,8 @@ JNIEXPORT void JNICALL JNICALL Java_io_realm_internal_TableQuery_nativeNotEqual_
                                                                                        jlongArray tablePointers,
                                                                                        jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -212,8 +213,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeGreater__J_3J_3JJ
                                                                               jlongArray columnIndexes,
                                                                               jlongArray tablePointers, jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -237,8 +238,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeGreaterEqual__J_3
                                                                                    jlongArray tablePointers,
                                                                                    jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -260,8 +261,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeLess__J_3J_3JJ(JN
                                                                            jlongArray columnIndexes,
                                                                            jlongArray tablePointers, jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -283,8 +284,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeLessEqual__J_3J_3
                                                                                 jlongArray columnIndexes,
                                                                                 jlongArray tablePointers, jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -307,7 +308,7 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeBetween__J_3JJJ(J
                                                                                jlongArray columnIndexes, jlong value1,
                                                                                jlong value2)
 {
-    JLongArrayAccessor arr(env, columnIndexes);
+    JLongArrayRegion arr(env, columnIndexes);
     jsize arr_len = arr.size();
     if (arr_len == 1) {
         if (!QUERY_COL_TYPE_VALID(env, nativeQueryPtr, arr[0], type_Int)) {
@@ -330,8 +331,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeEqual__J_3J_3JF(J
                                                                             jlongArray columnIndexes,
                                                                             jlongArray tablePointers, jfloat value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -355,8 +356,8 @@ JNIEXPORT void JNICALL JNICALL Java_io_realm_internal_TableQuery_nativeNotEqual_
                                                                                        jlongArray tablePointers,
                                                                                        jfloat value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -379,8 +380,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeGreater__J_3J_3JF
                                                                               jlongArray columnIndexes,
                                                                               jlongArray tablePointers, jfloat value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -404,8 +405,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeGreaterEqual__J_3
                                                                                    jlongArray tablePointers,
                                                                                    jfloat value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -427,8 +428,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeLess__J_3J_3JF(JN
                                                                            jlongArray columnIndexes,
                                                                            jlongArray tablePointers, jfloat value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -451,8 +452,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeLessEqual__J_3J_3
                                                                                 jlongArray tablePointers,
                                                                                 jfloat value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -475,7 +476,7 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeBetween__J_3JFF(J
                                                                                jlongArray columnIndexes,
                                                                                jfloat value1, jfloat value2)
 {
-    JLongArrayAccessor arr(env, columnIndexes);
+    JLongArrayRegion arr(env, columnIndexes);
     jsize arr_len = arr.size();
     try {
         if (arr_len == 1) {
@@ -499,8 +500,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeEqual__J_3J_3JD(J
                                                                             jlongArray columnIndexes,
                                                                             jlongArray tablePointers, jdouble value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -524,8 +525,8 @@ JNIEXPORT void JNICALL JNICALL Java_io_realm_internal_TableQuery_nativeNotEqual_
                                                                                        jlongArray tablePointers,
                                                                                        jdouble value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -548,8 +549,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeGreater__J_3J_3JD
                                                                               jlongArray columnIndexes,
                                                                               jlongArray tablePointers, jdouble value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -573,8 +574,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeGreaterEqual__J_3
                                                                                    jlongArray tablePointers,
                                                                                    jdouble value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -596,8 +597,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeLess__J_3J_3JD(JN
                                                                            jlongArray columnIndexes,
                                                                            jlongArray tablePointers, jdouble value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -621,8 +622,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeLessEqual__J_3J_3
                                                                                 jlongArray tablePointers,
                                                                                 jdouble value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -645,7 +646,7 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeBetween__J_3JDD(J
                                                                                jlongArray columnIndexes,
                                                                                jdouble value1, jdouble value2)
 {
-    JLongArrayAccessor arr(env, columnIndexes);
+    JLongArrayRegion arr(env, columnIndexes);
     jsize arr_len = arr.size();
     try {
         if (arr_len == 1) {
@@ -669,8 +670,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeEqualTimestamp(JN
                                                                               jlongArray columnIndexes,
                                                                               jlongArray tablePointers, jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -695,8 +696,8 @@ JNIEXPORT void JNICALL JNICALL Java_io_realm_internal_TableQuery_nativeNotEqualT
                                                                                          jlongArray tablePointers,
                                                                                          jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -720,8 +721,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeGreaterTimestamp(
                                                                                 jlongArray columnIndexes,
                                                                                 jlongArray tablePointers, jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -746,8 +747,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeGreaterEqualTimes
                                                                                      jlongArray tablePointers,
                                                                                      jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -771,8 +772,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeLessTimestamp(JNI
                                                                              jlongArray columnIndexes,
                                                                              jlongArray tablePointers, jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -797,8 +798,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeLessEqualTimestam
                                                                                   jlongArray tablePointers,
                                                                                   jlong value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -822,7 +823,7 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeBetweenTimestamp(
                                                                                 jlongArray columnIndexes,
                                                                                 jlong value1, jlong value2)
 {
-    JLongArrayAccessor arr(env, columnIndexes);
+    JLongArrayRegion arr(env, columnIndexes);
     jsize arr_len = arr.size();
     try {
         if (arr_len == 1) {
@@ -847,8 +848,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeEqual__J_3J_3JZ(J
                                                                             jlongArray columnIndexes,
                                                                             jlongArray tablePointers, jboolean value)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         if (arr_len == 1) {
@@ -875,8 +876,8 @@ static void TableQuery_StringPredicate(JNIEnv* env, jlong nativeQueryPtr, jlongA
                                        jlongArray tablePointers, jstring value,
                                        jboolean caseSensitive, StringPredicate predicate)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     try {
         TableRef table_ref = getTableForLinkQuery(nativeQueryPtr, table_arr, index_arr);
@@ -1004,8 +1005,8 @@ static void TableQuery_BinaryPredicate(JNIEnv* env, jlong nativeQueryPtr, jlongA
                                        jlongArray tablePointers, jbyteArray value, BinaryPredicate predicate)
 {
     try {
-        JLongArrayAccessor table_arr(env, tablePointers);
-        JLongArrayAccessor index_arr(env, columnIndexes);
+        JLongArrayRegion table_arr(env, tablePointers);
+        JLongArrayRegion index_arr(env, columnIndexes);
         jsize arr_len = index_arr.size();
         TableRef table_ref = getTableForLinkQuery(nativeQueryPtr, table_arr, index_arr);
 
@@ -1154,7 +1155,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_TableQuery_nativeFindAll(JNIEnv*
         return -1;
     }
     try {
-        TableView* tableView = new TableView(query->find_all(S(start), S(end), S(limit)));
+        TableView* tableView = new TrackedTableView(query->find_all(S(start), S(end), S(limit)));
         return reinterpret_cast<jlong>(tableView);
     }
     CATCH_STD()
@@ -1495,8 +1496,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeIsNull(JNIEnv* en
                                                                       jlongArray tablePointers)
 {
     try {
-        JLongArrayAccessor table_arr(env, tablePointers);
-        JLongArrayAccessor index_arr(env, columnIndexes);
+        JLongArrayRegion table_arr(env, tablePointers);
+        JLongArrayRegion index_arr(env, columnIndexes);
         jsize arr_len = index_arr.size();
         auto pQuery = reinterpret_cast<Query *>(nativeQueryPtr);
 
@@ -1575,8 +1576,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeIsNotNull(JNIEnv*
                                                                          jlongArray columnIndexes,
                                                                          jlongArray tablePointers)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     Query* pQuery = Q(nativeQueryPtr);
     try {
@@ -1657,8 +1658,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeIsEmpty(JNIEnv* e
                                                                        jlongArray columnIndexes,
                                                                        jlongArray tablePointers)
 {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     Query* pQuery = reinterpret_cast<Query *>(nativeQueryPtr);
     try {
@@ -1728,8 +1729,8 @@ JNIEXPORT void JNICALL Java_io_realm_internal_TableQuery_nativeIsEmpty(JNIEnv* e
 JNIEXPORT void JNICALL
 Java_io_realm_internal_TableQuery_nativeIsNotEmpty(JNIEnv *env, jobject, jlong nativeQueryPtr,
                                                    jlongArray columnIndexes, jlongArray tablePointers) {
-    JLongArrayAccessor table_arr(env, tablePointers);
-    JLongArrayAccessor index_arr(env, columnIndexes);
+    JLongArrayRegion table_arr(env, tablePointers);
+    JLongArrayRegion index_arr(env, columnIndexes);
     jsize arr_len = index_arr.size();
     Query* pQuery = reinterpret_cast<Query *>(nativeQueryPtr);
     try {
@@ -17,7 +17,9 @@
 #include "io_realm_internal_UncheckedRow.h"
 #include "io_realm_internal_Property.h"
 
+#include "column_index_cache.hpp"
 #include "java_accessor.hpp"
+#include "native_object_stats.hpp"
 #include "util.hpp"
 
 using namespace realm;
@@ -61,8 +63,7 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_UncheckedRow_nativeGetColumnIndex
     }
 
     try {
-        JStringAccessor columnName2(env, columnName);                                   // throws
-        return to_jlong_or_not_found(ROW(nativeRowPtr)->get_column_index(columnName2)); // noexcept
+        return to_jlong_or_not_found(find_column_index(env, *ROW(nativeRowPtr)->get_table(), columnName)); // throws
     }
     CATCH_STD()
     return 0;
@@ -394,6 +395,7 @@ static void finalize_unchecked_row(jlong ptr)
 {
     TR_ENTER_PTR(ptr)
     delete ROW(ptr);
+    NativeObjectStats::on_destroy(NativeObjectStats::Type::Row, sizeof(Row));
 }
 
 JNIEXPORT jlong JNICALL Java_io_realm_internal_UncheckedRow_nativeGetFinalizerPtr(JNIEnv*, jclass)
@@ -18,6 +18,7 @@
 
 #include "jni_util/jni_utils.hpp"
 #include "jni_util/hack.hpp"
+#include "jni_util/native_methods.hpp"
 #include "java_class_global_def.hpp"
 
 #include <realm/string_data.hpp>
@@ -49,6 +50,7 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*)
     else {
         JniUtils::initialize(vm, JNI_VERSION_1_6);
         JavaClassGlobalDef::initialize(env);
+        register_natives(env);
     }
 
     return JNI_VERSION_1_6;
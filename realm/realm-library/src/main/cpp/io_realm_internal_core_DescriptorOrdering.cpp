@@ -19,6 +19,7 @@
 #include <realm/views.hpp>
 
 #include "java_query_descriptor.hpp"
+#include "native_object_stats.hpp"
 #include "util.hpp"
 
 using namespace realm;
@@ -30,6 +31,7 @@ static void finalize_descriptor(jlong ptr)
 {
     TR_ENTER_PTR(ptr)
     delete reinterpret_cast<DescriptorOrdering*>(ptr);
+    NativeObjectStats::on_destroy(NativeObjectStats::Type::DescriptorOrdering, sizeof(DescriptorOrdering));
 }
 
 JNIEXPORT jlong JNICALL Java_io_realm_internal_core_DescriptorOrdering_nativeGetFinalizerMethodPtr(JNIEnv*, jclass)
@@ -42,7 +44,9 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_core_DescriptorOrdering_nativeCre
 {
    TR_ENTER()
    try {
-        return reinterpret_cast<jlong>(new DescriptorOrdering());
+        auto descriptor = new DescriptorOrdering();
+        NativeObjectStats::on_create(NativeObjectStats::Type::DescriptorOrdering, sizeof(DescriptorOrdering));
+        return reinterpret_cast<jlong>(descriptor);
     }
     CATCH_STD()
     return reinterpret_cast<jlong>(nullptr);
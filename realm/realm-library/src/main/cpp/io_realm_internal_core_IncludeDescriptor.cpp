@@ -54,8 +54,8 @@ JNIEXPORT jlong JNICALL Java_io_realm_internal_core_IncludeDescriptor_nativeCrea
 {
     TR_ENTER()
     try {
-        JLongArrayAccessor table_arr(env, table_pointers);
-        JLongArrayAccessor index_arr(env, column_indexes);
+        JLongArrayRegion table_arr(env, table_pointers);
+        JLongArrayRegion index_arr(env, column_indexes);
         auto starting_table = reinterpret_cast<Table*>(starting_table_ptr);
         std::vector<LinkPathPart> parts;
         parts.reserve(index_arr.size());
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_realm_internal_objectstore_OsColumnarExporter.h"
+
+#include <results.hpp>
+
+#include "columnar_results_exporter.hpp"
+#include "java_accessor.hpp"
+#include "observable_collection_wrapper.hpp"
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+typedef ObservableCollectionWrapper<Results> ResultsWrapper;
+
+static const size_t layout_header_size = 2;
+static const size_t layout_column_size = 8;
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsColumnarExporter_nativeCreate(JNIEnv* env, jclass,
+                                                                                           jlong results_ptr,
+                                                                                           jobjectArray j_properties)
+{
+    TR_ENTER_PTR(results_ptr)
+    try {
+        auto& wrapper = *reinterpret_cast<ResultsWrapper*>(results_ptr);
+        JObjectArrayAccessor<JStringAccessor, jstring> properties_accessor(env, j_properties);
+        std::vector<std::string> properties;
+        properties.reserve(properties_accessor.size());
+        for (jsize i = 0; i < properties_accessor.size(); ++i) {
+            properties.push_back(std::string(StringData(properties_accessor[i])));
+        }
+        return reinterpret_cast<jlong>(new ColumnarResultsExporter(wrapper.collection(), properties));
+    }
+    CATCH_STD()
+    return 0;
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsColumnarExporter_nativeDestroy(JNIEnv*, jclass,
+                                                                                           jlong exporter_ptr)
+{
+    TR_ENTER_PTR(exporter_ptr)
+    delete reinterpret_cast<ColumnarResultsExporter*>(exporter_ptr);
+}
+
+JNIEXPORT jlongArray JNICALL Java_io_realm_internal_objectstore_OsColumnarExporter_nativeGetLayout(JNIEnv* env,
+                                                                                                   jclass,
+                                                                                                   jlong exporter_ptr)
+{
+    TR_ENTER_PTR(exporter_ptr)
+    try {
+        auto& exporter = *reinterpret_cast<ColumnarResultsExporter*>(exporter_ptr);
+        // {row_count, required_size, then for each column: property_type, null_count, validity_offset,
+        // validity_size, values_offset, values_size, data_offset, data_size}
+        std::vector<jlong> layout;
+        layout.reserve(layout_header_size + exporter.columns().size() * layout_column_size);
+        layout.push_back(static_cast<jlong>(exporter.row_count()));
+        layout.push_back(static_cast<jlong>(exporter.required_size()));
+        for (auto& column : exporter.columns()) {
+            layout.push_back(static_cast<jlong>(column.type));
+            layout.push_back(static_cast<jlong>(column.null_count));
+            layout.push_back(static_cast<jlong>(column.validity.offset));
+            layout.push_back(static_cast<jlong>(column.validity.size));
+            layout.push_back(static_cast<jlong>(column.values.offset));
+            layout.push_back(static_cast<jlong>(column.values.size));
+            layout.push_back(static_cast<jlong>(column.data.offset));
+            layout.push_back(static_cast<jlong>(column.data.size));
+        }
+
+        jsize length = static_cast<jsize>(layout.size());
+        jlongArray layout_array = env->NewLongArray(length);
+        if (!layout_array) {
+            ThrowException(env, OutOfMemory, "Could not allocate memory to return the columnar layout.");
+            return nullptr;
+        }
+        env->SetLongArrayRegion(layout_array, 0, length, layout.data());
+        return layout_array;
+    }
+    CATCH_STD()
+    return nullptr;
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsColumnarExporter_nativeWrite(JNIEnv* env, jclass,
+                                                                                         jlong exporter_ptr,
+                                                                                         jobject buffer, jlong offset,
+                                                                                         jlong size)
+{
+    TR_ENTER_PTR(exporter_ptr)
+    try {
+        auto& exporter = *reinterpret_cast<ColumnarResultsExporter*>(exporter_ptr);
+        auto data = static_cast<char*>(env->GetDirectBufferAddress(buffer));
+        if (!data) {
+            throw std::invalid_argument("The columns can only be written into a direct ByteBuffer.");
+        }
+        if (offset < 0 || size < 0 || offset + size > env->GetDirectBufferCapacity(buffer)) {
+            throw std::invalid_argument(util::format("Invalid range %1 + %2 in the buffer.", offset, size));
+        }
+        exporter.write(data + offset, static_cast<size_t>(size));
+    }
+    CATCH_STD()
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_realm_internal_objectstore_OsColumnarImporter.h"
+
+#include <shared_realm.hpp>
+
+#include "columnar_table_importer.hpp"
+#include "java_accessor.hpp"
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+static const jsize layout_column_size = 6;
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsColumnarImporter_nativeImport(
+    JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr, jobject buffer, jlong buffer_offset,
+    jlong row_count, jobjectArray j_properties, jlongArray j_layout, jboolean update_existing)
+{
+    TR_ENTER_PTR(table_ptr)
+    try {
+        auto& shared_realm = *reinterpret_cast<SharedRealm*>(shared_realm_ptr);
+        auto& table = *reinterpret_cast<Table*>(table_ptr);
+        auto base = static_cast<const char*>(env->GetDirectBufferAddress(buffer));
+        if (!base) {
+            throw std::invalid_argument("The columns can only be imported from a direct ByteBuffer.");
+        }
+        jlong capacity = env->GetDirectBufferCapacity(buffer);
+        if (buffer_offset < 0 || buffer_offset > capacity || row_count < 0) {
+            throw std::invalid_argument(
+                util::format("Invalid offset %1 or row count %2 in the buffer.", buffer_offset, row_count));
+        }
+        base += buffer_offset;
+        capacity -= buffer_offset;
+
+        JObjectArrayAccessor<JStringAccessor, jstring> properties(env, j_properties);
+        JLongArrayAccessor layout(env, j_layout);
+        if (layout.size() != properties.size() * layout_column_size) {
+            throw std::invalid_argument("The layout doesn't match the number of columns.");
+        }
+        // {validity_offset, validity_size, values_offset, values_size, data_offset, data_size} for each column.
+        auto buffer_at = [&](jsize index) {
+            jlong offset = layout[index];
+            jlong size = layout[index + 1];
+            if (offset < 0 || size < 0 || offset > capacity || size > capacity - offset) {
+                throw std::invalid_argument(util::format("Invalid range %1 + %2 in the buffer.", offset, size));
+            }
+            return BinaryData(base + offset, static_cast<size_t>(size));
+        };
+        std::vector<ColumnarImportColumn> columns;
+        columns.reserve(properties.size());
+        for (jsize i = 0; i < properties.size(); ++i) {
+            ColumnarImportColumn column;
+            column.property_name = std::string(StringData(properties[i]));
+            column.validity = buffer_at(i * layout_column_size);
+            column.values = buffer_at(i * layout_column_size + 2);
+            column.data = buffer_at(i * layout_column_size + 4);
+            columns.push_back(std::move(column));
+        }
+        return static_cast<jlong>(import_columns(env, shared_realm, table, columns, static_cast<size_t>(row_count),
+                                                 update_existing == JNI_TRUE));
+    }
+    CATCH_STD()
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "io_realm_internal_objectstore_OsImportPipeline.h"
+
+#include "java_accessor.hpp"
+#include "java_object_accessor.hpp"
+#include "java_object_batch.hpp"
+#include "java_object_data_reader.hpp"
+#include "native_object_stats.hpp"
+#include "schema_cache.hpp"
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::jni_util;
+using namespace realm::_impl;
+
+static void destroy_batch(JavaObjectBatch* batch) noexcept
+{
+    // The batch is not modified after it has been prepared, so the estimated size is still the same.
+    NativeObjectStats::on_destroy(NativeObjectStats::Type::ObjectBuilder, batch->estimated_size());
+    delete batch;
+}
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsImportPipeline_nativeCreateObjectSchema(
+    JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr)
+{
+    TR_ENTER()
+    try {
+        SharedRealm shared_realm = *(reinterpret_cast<SharedRealm*>(shared_realm_ptr));
+        Table* table = reinterpret_cast<realm::Table*>(table_ptr);
+        // A copy, so it can be read by the producer threads while the Realm is being written.
+        return reinterpret_cast<jlong>(new ObjectSchema(object_schema_for_table(shared_realm, *table)));
+    }
+    CATCH_STD()
+    return 0;
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsImportPipeline_nativeDestroyObjectSchema(
+    JNIEnv*, jclass, jlong object_schema_ptr)
+{
+    TR_ENTER()
+    delete reinterpret_cast<ObjectSchema*>(object_schema_ptr);
+}
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsImportPipeline_nativePrepareBatch(
+    JNIEnv* env, jclass, jlong object_schema_ptr, jlong column_count, jobject buffer, jlong buffer_size)
+{
+    TR_ENTER()
+    try {
+        // Called from the producer threads, nothing here may touch the Realm.
+        const ObjectSchema& object_schema = *reinterpret_cast<ObjectSchema*>(object_schema_ptr);
+        JavaObjectDataReader reader(env, buffer, buffer_size);
+        std::unique_ptr<JavaObjectBatch> batch(new JavaObjectBatch(column_count));
+        while (!reader.at_end()) {
+            JavaValue* values = batch->add_object();
+            reader.read_object(values, batch->column_count(), batch->arena());
+            validate_object_values(object_schema, values, batch->column_count());
+        }
+        NativeObjectStats::on_create(NativeObjectStats::Type::ObjectBuilder, batch->estimated_size());
+        return reinterpret_cast<jlong>(batch.release());
+    }
+    CATCH_STD()
+    return 0;
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsImportPipeline_nativeDestroyBatch(JNIEnv*, jclass,
+                                                                                               jlong batch_ptr)
+{
+    TR_ENTER()
+    destroy_batch(reinterpret_cast<JavaObjectBatch*>(batch_ptr));
+}
+
+JNIEXPORT jlongArray JNICALL Java_io_realm_internal_objectstore_OsImportPipeline_nativeWriteBatches(
+    JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr, jlongArray batch_ptrs_array,
+    jboolean update_existing, jboolean ignore_same_values)
+{
+    TR_ENTER()
+    try {
+        // The batches are still owned by Java, which frees them whether writing them succeeds or not.
+        JLongArrayRegion batch_ptrs(env, batch_ptrs_array);
+        std::vector<JavaObjectBatch*> batches;
+        batches.reserve(batch_ptrs.size());
+        size_t object_count = 0;
+        for (jsize i = 0; i < batch_ptrs.size(); ++i) {
+            batches.push_back(reinterpret_cast<JavaObjectBatch*>(batch_ptrs[i]));
+            object_count += batches.back()->size();
+        }
+
+        SharedRealm shared_realm = *(reinterpret_cast<SharedRealm*>(shared_realm_ptr));
+        Table* table = reinterpret_cast<realm::Table*>(table_ptr);
+        const ObjectSchema& object_schema = object_schema_for_table(shared_realm, *table);
+        JavaContext ctx(env, shared_realm, object_schema);
+
+        // Everything has been decoded and validated already, only the writes are left.
+        std::vector<jlong> row_indices;
+        row_indices.reserve(object_count);
+        for (auto batch : batches) {
+            for (size_t i = 0; i < batch->size(); ++i) {
+                JavaValue values = batch->object_at(i);
+                Object obj =
+                    Object::create(ctx, shared_realm, object_schema, values, update_existing, ignore_same_values);
+                row_indices.push_back(static_cast<jlong>(obj.row().get_index()));
+            }
+        }
+
+        jsize length = static_cast<jsize>(row_indices.size());
+        jlongArray row_indices_array = env->NewLongArray(length);
+        if (!row_indices_array) {
+            ThrowException(env, OutOfMemory, "Could not allocate memory to return the row indices.");
+            return nullptr;
+        }
+        env->SetLongArrayRegion(row_indices_array, 0, length, row_indices.data());
+        return row_indices_array;
+    }
+    CATCH_STD()
+    return nullptr;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "io_realm_internal_objectstore_OsJsonExporter.h"
+
+#include <results.hpp>
+
+#include "java_accessor.hpp"
+#include "json_object_exporter.hpp"
+#include "observable_collection_wrapper.hpp"
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+typedef ObservableCollectionWrapper<Results> ResultsWrapper;
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsJsonExporter_nativeCreate(JNIEnv* env, jclass,
+                                                                                       jlong results_ptr,
+                                                                                       jobjectArray j_properties,
+                                                                                       jint link_depth)
+{
+    TR_ENTER_PTR(results_ptr)
+    try {
+        auto& wrapper = *reinterpret_cast<ResultsWrapper*>(results_ptr);
+        JObjectArrayAccessor<JStringAccessor, jstring> properties_accessor(env, j_properties);
+        std::vector<std::string> properties;
+        properties.reserve(properties_accessor.size());
+        for (jsize i = 0; i < properties_accessor.size(); ++i) {
+            properties.push_back(std::string(StringData(properties_accessor[i])));
+        }
+        auto exporter = new JsonResultsExporter(wrapper.collection(), properties, static_cast<size_t>(link_depth));
+        return reinterpret_cast<jlong>(exporter);
+    }
+    CATCH_STD()
+    return 0;
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsJsonExporter_nativeDestroy(JNIEnv*, jclass,
+                                                                                       jlong exporter_ptr)
+{
+    TR_ENTER_PTR(exporter_ptr)
+    delete reinterpret_cast<JsonResultsExporter*>(exporter_ptr);
+}
+
+JNIEXPORT jint JNICALL Java_io_realm_internal_objectstore_OsJsonExporter_nativeRead(JNIEnv* env, jclass,
+                                                                                    jlong exporter_ptr,
+                                                                                    jobject buffer, jint offset,
+                                                                                    jint size)
+{
+    TR_ENTER_PTR(exporter_ptr)
+    try {
+        auto& exporter = *reinterpret_cast<JsonResultsExporter*>(exporter_ptr);
+        auto data = static_cast<char*>(env->GetDirectBufferAddress(buffer));
+        if (!data) {
+            throw std::invalid_argument("The JSON can only be read into a direct ByteBuffer.");
+        }
+        if (offset < 0 || size < 0 || offset + static_cast<jlong>(size) > env->GetDirectBufferCapacity(buffer)) {
+            throw std::invalid_argument(util::format("Invalid range %1 + %2 in the buffer.", offset, size));
+        }
+        return static_cast<jint>(exporter.read(data + offset, static_cast<size_t>(size)));
+    }
+    CATCH_STD()
+    return 0;
+}
+
+JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsJsonExporter_nativeWriteToFd(JNIEnv* env, jclass,
+                                                                                         jlong exporter_ptr, jint fd)
+{
+    TR_ENTER_PTR(exporter_ptr)
+    try {
+        reinterpret_cast<JsonResultsExporter*>(exporter_ptr)->write_to_fd(fd);
+    }
+    CATCH_STD()
+}
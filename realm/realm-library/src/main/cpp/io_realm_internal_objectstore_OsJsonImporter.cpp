@@ -0,0 +1,79 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "io_realm_internal_objectstore_OsJsonImporter.h"
+
+#include "json_object_importer.hpp"
+#include "schema_cache.hpp"
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+static jlong import_json(JNIEnv* env, jlong shared_realm_ptr, jlong table_ptr, JsonSource& source,
+                         jboolean update_existing)
+{
+    SharedRealm shared_realm = *(reinterpret_cast<SharedRealm*>(shared_realm_ptr));
+    Table* table = reinterpret_cast<realm::Table*>(table_ptr);
+    const ObjectSchema& object_schema = object_schema_for_table(shared_realm, *table);
+    return static_cast<jlong>(
+        import_json_objects(env, std::move(shared_realm), object_schema, source, to_bool(update_existing)));
+}
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsJsonImporter_nativeImportFromFd(
+    JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr, jint fd, jboolean update_existing)
+{
+    TR_ENTER()
+    try {
+        JsonFdSource source(fd);
+        return import_json(env, shared_realm_ptr, table_ptr, source, update_existing);
+    }
+    CATCH_STD()
+    return 0;
+}
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsJsonImporter_nativeImportFromBuffer(
+    JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr, jobject buffer, jlong buffer_size,
+    jboolean update_existing)
+{
+    TR_ENTER()
+    try {
+        auto data = static_cast<const char*>(env->GetDirectBufferAddress(buffer));
+        if (!data) {
+            throw std::invalid_argument("The JSON is not stored in a direct ByteBuffer.");
+        }
+        if (buffer_size < 0 || buffer_size > env->GetDirectBufferCapacity(buffer)) {
+            throw std::invalid_argument(util::format("Invalid JSON size %1.", buffer_size));
+        }
+        JsonMemorySource source(data, static_cast<size_t>(buffer_size));
+        return import_json(env, shared_realm_ptr, table_ptr, source, update_existing);
+    }
+    CATCH_STD()
+    return 0;
+}
+
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsJsonImporter_nativeImportFromStream(
+    JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr, jobject input_stream, jboolean update_existing)
+{
+    TR_ENTER()
+    try {
+        JsonInputStreamSource source(env, input_stream);
+        return import_json(env, shared_realm_ptr, table_ptr, source, update_existing);
+    }
+    CATCH_STD()
+    return 0;
+}
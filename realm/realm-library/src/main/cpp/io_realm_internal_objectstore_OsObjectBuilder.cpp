@@ -17,6 +17,10 @@
 #include "io_realm_internal_objectstore_OsObjectBuilder.h"
 
 #include "java_object_accessor.hpp"
+#include "java_object_data.hpp"
+#include "java_object_data_reader.hpp"
+#include "native_object_stats.hpp"
+#include "schema_cache.hpp"
 #include "util.hpp"
 
 #include <realm/util/any.hpp>
@@ -25,291 +29,83 @@ using namespace realm;
 using namespace realm::jni_util;
 using namespace realm::_impl;
 
-typedef std::vector<JavaValue> OsObjectData;
-
 JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeDestroyBuilder(JNIEnv*, jclass, jlong data_ptr)
 {
     TR_ENTER()
-    delete reinterpret_cast<OsObjectData*>(data_ptr);
+    auto data = reinterpret_cast<JavaObjectData*>(data_ptr);
+    // The data is not modified after it has been created, so the estimated size is still the same.
+    NativeObjectStats::on_destroy(NativeObjectStats::Type::ObjectBuilder, data->estimated_size());
+    delete data;
 }
 
-JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeCreateBuilder(JNIEnv* env, jclass, jlong size)
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeCreateBuilderFromBuffer
+        (JNIEnv* env, jclass, jlong column_count, jobject buffer, jlong buffer_size)
 {
     TR_ENTER()
     try {
-        auto list = new std::vector<JavaValue>(size);
-        return reinterpret_cast<jlong>(list);
-    }
-    CATCH_STD()
-    return -1;
-}
-
-static inline void add_property(jlong data_ptr, jlong column_index, JavaValue const& value)
-{
-    OsObjectData* data = reinterpret_cast<OsObjectData*>(data_ptr);
-    data->at(column_index) = std::move(value);
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddNull
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index)
-{
-    try {
-        const JavaValue value = JavaValue();
-        add_property(data_ptr, column_index, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddString
-    (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jstring j_value)
-{
-    try {
-        JStringAccessor value(env, j_value);
-        std::string string_value(value);
-        const JavaValue wrapped_value(string_value);
-        add_property(data_ptr, column_index, wrapped_value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddInteger
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jlong j_value)
-{
-    try {
-        const JavaValue value(j_value);
-        add_property(data_ptr, column_index, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddFloat
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jfloat j_value)
-{
-    try {
-        const JavaValue value(j_value);
-        add_property(data_ptr, column_index, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddDouble
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jdouble j_value)
-{
-    try {
-        const JavaValue value(j_value);
-        add_property(data_ptr, column_index, value);
+        JavaObjectDataReader reader(env, buffer, buffer_size);
+        std::unique_ptr<JavaObjectData> data(new JavaObjectData(column_count));
+        reader.read_object(*data);
+        NativeObjectStats::on_create(NativeObjectStats::Type::ObjectBuilder, data->estimated_size());
+        return reinterpret_cast<jlong>(data.release());
     }
     CATCH_STD()
+    return 0;
 }
 
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddBoolean
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jboolean j_value)
-{
-    try {
-        const JavaValue value(j_value);
-        add_property(data_ptr, column_index, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddByteArray
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jbyteArray j_value)
-{
-    try {
-        auto data = OwnedBinaryData(JByteArrayAccessor(env, j_value).transform<BinaryData>());
-        const JavaValue value(data);
-        add_property(data_ptr, column_index, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddDate
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jlong j_value)
-{
-    try {
-        const JavaValue value(from_milliseconds(j_value));
-        add_property(data_ptr, column_index, value);
-    }
-    CATCH_STD()
-}
-
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddObject
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jlong row_ptr)
-{
-    try {
-        const JavaValue value(reinterpret_cast<RowExpr*>(row_ptr));
-        add_property(data_ptr, column_index, value);
-    }
-    CATCH_STD()
-}
-
-static inline const ObjectSchema& get_schema(const Schema& schema, Table* table)
-{
-    std::string table_name(table->get_name());
-    std::string class_name = std::string(table_name.substr(TABLE_PREFIX.length()));
-    auto it = schema.find(class_name);
-    if (it == schema.end()) {
-        throw std::runtime_error(format("Class '%1' cannot be found in the schema.", class_name.data()));
-    }
-    return *it;
-}
-
-JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeCreateOrUpdate
-        (JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr, jlong builder_ptr, jboolean update_existing, jboolean ignore_same_values)
+JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeCreateOrUpdateFromBuffer
+        (JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr, jlong column_count, jobject buffer,
+         jlong buffer_size, jboolean update_existing, jboolean ignore_same_values)
 {
     try {
         SharedRealm shared_realm = *(reinterpret_cast<SharedRealm*>(shared_realm_ptr));
         Table* table = reinterpret_cast<realm::Table*>(table_ptr);
-        const auto& schema = shared_realm->schema();
-        const ObjectSchema& object_schema = get_schema(schema, table);
+        const ObjectSchema& object_schema = object_schema_for_table(shared_realm, *table);
         JavaContext ctx(env, shared_realm, object_schema);
-        auto list = *reinterpret_cast<OsObjectData*>(builder_ptr);
-        JavaValue values = JavaValue(list);
-        Object obj = Object::create(ctx, shared_realm, object_schema, values, update_existing, ignore_same_values);
-        return reinterpret_cast<jlong>(new Row(obj.row()));
-    }
-    CATCH_STD()
-    return realm::npos;
-}
 
-JNIEXPORT jlong JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeStartList
-        (JNIEnv* env, jclass, jlong list_size)
-{
-    try {
-        auto list = new std::vector<JavaValue>();
-        list->reserve(list_size);
-        return reinterpret_cast<jlong>(list);
+        JavaObjectDataReader reader(env, buffer, buffer_size);
+        JavaObjectData data(column_count);
+        reader.read_object(data);
+        JavaValue values = data.as_value();
+        Object obj = Object::create(ctx, shared_realm, object_schema, values, update_existing, ignore_same_values);
+        return reinterpret_cast<jlong>(new_tracked_row(obj.row()));
     }
     CATCH_STD()
     return realm::npos;
 }
 
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeStopList
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jlong list_ptr)
+JNIEXPORT jlongArray JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeCreateOrUpdateBatchFromBuffer
+        (JNIEnv* env, jclass, jlong shared_realm_ptr, jlong table_ptr, jlong column_count, jobject buffer,
+         jlong buffer_size, jboolean update_existing, jboolean ignore_same_values)
 {
     try {
-        auto list = reinterpret_cast<std::vector<JavaValue>*>(list_ptr);
-        const JavaValue value((*list));
-        add_property(data_ptr, column_index, value);
-        delete list;
-    }
-    CATCH_STD()
-}
-
+        // The schema, the context and the object data (including its arena) are shared by all objects in the batch.
+        SharedRealm shared_realm = *(reinterpret_cast<SharedRealm*>(shared_realm_ptr));
+        Table* table = reinterpret_cast<realm::Table*>(table_ptr);
+        const ObjectSchema& object_schema = object_schema_for_table(shared_realm, *table);
+        JavaContext ctx(env, shared_realm, object_schema);
 
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddObjectList
-        (JNIEnv* env, jclass, jlong data_ptr, jlong column_index, jlongArray row_ptrs)
-{
-    try {
-        auto rows = JLongArrayAccessor(env, row_ptrs);
-        auto list = std::vector<JavaValue>();
-        list.reserve(rows.size());
-        for (jsize i = 0; i < rows.size(); ++i) {
-            auto item = JavaValue(reinterpret_cast<RowExpr*>(rows[i]));
-            list.push_back(item);
+        JavaObjectDataReader reader(env, buffer, buffer_size);
+        JavaObjectData data(column_count);
+        JavaValue values = data.as_value();
+        std::vector<jlong> row_indices;
+        while (!reader.at_end()) {
+            // Columns not set for this object must not keep the values of the previous one.
+            data.reset();
+            reader.read_object(data);
+            Object obj = Object::create(ctx, shared_realm, object_schema, values, update_existing, ignore_same_values);
+            row_indices.push_back(static_cast<jlong>(obj.row().get_index()));
         }
-        JavaValue value(list);
-        add_property(data_ptr, column_index, value);
-    }
-    CATCH_STD()
-}
-
-static inline void add_list_element(jlong list_ptr, JavaValue const& value)
-{
-    auto list = reinterpret_cast<std::vector<JavaValue>*>(list_ptr);
-    list->push_back(std::move(value));
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddNullListItem
-        (JNIEnv* env, jclass, jlong list_ptr)
-{
-    try {
-        const JavaValue value = JavaValue();
-        add_list_element(list_ptr, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddIntegerListItem
-        (JNIEnv* env, jclass, jlong list_ptr, jlong j_value)
-{
-    try {
-        const JavaValue value(j_value);
-        add_list_element(list_ptr, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddStringListItem
-    (JNIEnv* env, jclass, jlong list_ptr, jstring j_value)
-{
-    try {
-        JStringAccessor value(env, j_value);
-        std::string string_value(value);
-        const JavaValue wrapped_value(string_value);
-        add_list_element(list_ptr, wrapped_value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddFloatListItem
-        (JNIEnv* env, jclass, jlong list_ptr, jfloat j_value)
-{
-    try {
-        const JavaValue value(j_value);
-        add_list_element(list_ptr, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddDoubleListItem
-        (JNIEnv* env, jclass, jlong list_ptr, jdouble j_value)
-{
-    try {
-        const JavaValue value(j_value);
-        add_list_element(list_ptr, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddBooleanListItem
-        (JNIEnv* env, jclass, jlong list_ptr, jboolean j_value)
-{
-    try {
-        const JavaValue value(j_value);
-        add_list_element(list_ptr, value);
-    }
-    CATCH_STD()
-}
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddByteArrayListItem
-        (JNIEnv* env, jclass, jlong list_ptr, jbyteArray j_value)
-{
-    try {
-        auto data = OwnedBinaryData(JByteArrayAccessor(env, j_value).transform<BinaryData>());
-        const JavaValue value(data);
-        add_list_element(list_ptr, value);
-    }
-    CATCH_STD()
-}
 
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddDateListItem
-        (JNIEnv* env, jclass, jlong list_ptr, jlong j_value)
-{
-    try {
-        const JavaValue value(from_milliseconds(j_value));
-        add_list_element(list_ptr, value);
+        jsize length = static_cast<jsize>(row_indices.size());
+        jlongArray row_indices_array = env->NewLongArray(length);
+        if (!row_indices_array) {
+            ThrowException(env, OutOfMemory, "Could not allocate memory to return the row indices.");
+            return nullptr;
+        }
+        env->SetLongArrayRegion(row_indices_array, 0, length, row_indices.data());
+        return row_indices_array;
     }
     CATCH_STD()
+    return nullptr;
 }
-
-JNIEXPORT void JNICALL Java_io_realm_internal_objectstore_OsObjectBuilder_nativeAddObjectListItem
-        (JNIEnv* env, jclass, jlong list_ptr, jlong row_ptr)
-{
-    try {
-        const JavaValue value(reinterpret_cast<RowExpr*>(row_ptr));
-        add_list_element(list_ptr, value);
-    }
-    CATCH_STD()
-}
\ No newline at end of file
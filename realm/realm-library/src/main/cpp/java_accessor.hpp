@@ -44,6 +44,12 @@ class JPrimitiveArrayAccessor;
 typedef JPrimitiveArrayAccessor<jbyteArray, jbyte> JByteArrayAccessor;
 typedef JPrimitiveArrayAccessor<jbooleanArray, jboolean> JBooleanArrayAccessor;
 typedef JPrimitiveArrayAccessor<jlongArray, jlong> JLongArrayAccessor;
+typedef JPrimitiveArrayAccessor<jfloatArray, jfloat> JFloatArrayAccessor;
+typedef JPrimitiveArrayAccessor<jdoubleArray, jdouble> JDoubleArrayAccessor;
+
+template <typename, typename, size_t>
+class JPrimitiveArrayRegion;
+typedef JPrimitiveArrayRegion<jlongArray, jlong, 8> JLongArrayRegion;
 
 // JPrimitiveArrayAccessor and JObjectArrayAccessor are not supposed to be used across JNI borders. They won't acquire
 // references of the original Java object. Thus, you have to ensure the original java object is available during the
@@ -118,6 +124,63 @@ private:
     }
 };
 
+// Copy of a Java primitive array made with GetXxxArrayRegion. Arrays with up to InlineCapacity elements are copied
+// into the accessor itself, so reading the small arrays passed to most JNI calls (e.g.: the column indices and table
+// pointers of a link path) doesn't allocate at all. Bigger arrays are copied into a single heap buffer.
+// Unlike JPrimitiveArrayAccessor, it doesn't pin or copy the array through the VM and there is nothing to release.
+// GetPrimitiveArrayCritical is not used since most of the callers may throw or call other JNI functions while the
+// elements are still in use, which is not allowed in a critical region.
+// Changes to the elements are not written back to the Java array.
+template <typename ArrayType, typename ElementType, size_t InlineCapacity>
+class JPrimitiveArrayRegion {
+public:
+    JPrimitiveArrayRegion(JNIEnv* env, ArrayType jarray)
+        : m_is_null(jarray == nullptr)
+        , m_size(jarray ? env->GetArrayLength(jarray) : 0)
+        , m_data(m_inline_data)
+    {
+        if (static_cast<size_t>(m_size) > InlineCapacity) {
+            m_heap_data.reset(new ElementType[m_size]);
+            m_data = m_heap_data.get();
+        }
+        if (m_size > 0) {
+            get_region(env, jarray, m_size, m_data);
+        }
+    }
+
+    JPrimitiveArrayRegion(const JPrimitiveArrayRegion&) = delete;
+    JPrimitiveArrayRegion& operator=(const JPrimitiveArrayRegion&) = delete;
+
+    inline bool is_null() const noexcept
+    {
+        return m_is_null;
+    }
+
+    inline jsize size() const noexcept
+    {
+        return m_size;
+    }
+
+    inline const ElementType* data() const noexcept
+    {
+        return m_data;
+    }
+
+    inline const ElementType& operator[](const int index) const noexcept
+    {
+        return m_data[index];
+    }
+
+private:
+    static void get_region(JNIEnv* env, ArrayType jarray, jsize size, ElementType* buf);
+
+    const bool m_is_null;
+    const jsize m_size;
+    ElementType* m_data;
+    ElementType m_inline_data[InlineCapacity];
+    std::unique_ptr<ElementType[]> m_heap_data;
+};
+
 // Accessor for Java object arrays
 template <typename AccessorType, typename ObjectType>
 class JObjectArrayAccessor {
@@ -343,6 +406,70 @@ inline JPrimitiveArrayAccessor<jlongArray, jlong>::ElementsHolder::~ElementsHold
     }
 }
 
+// Accessor for jfloatArray
+template <>
+inline JPrimitiveArrayAccessor<jfloatArray, jfloat>::ElementsHolder::ElementsHolder(JNIEnv* env, jfloatArray jarray)
+    : m_env(env)
+    , m_jarray(jarray)
+    , m_data_ptr(jarray ? env->GetFloatArrayElements(jarray, nullptr) : nullptr)
+{
+}
+
+template <>
+inline JPrimitiveArrayAccessor<jfloatArray, jfloat>::ElementsHolder::~ElementsHolder()
+{
+    if (m_jarray) {
+        m_env->ReleaseFloatArrayElements(m_jarray, m_data_ptr, m_release_mode);
+    }
+}
+
+// Accessor for jdoubleArray
+template <>
+inline JPrimitiveArrayAccessor<jdoubleArray, jdouble>::ElementsHolder::ElementsHolder(JNIEnv* env,
+                                                                                      jdoubleArray jarray)
+    : m_env(env)
+    , m_jarray(jarray)
+    , m_data_ptr(jarray ? env->GetDoubleArrayElements(jarray, nullptr) : nullptr)
+{
+}
+
+template <>
+inline JPrimitiveArrayAccessor<jdoubleArray, jdouble>::ElementsHolder::~ElementsHolder()
+{
+    if (m_jarray) {
+        m_env->ReleaseDoubleArrayElements(m_jarray, m_data_ptr, m_release_mode);
+    }
+}
+
+template <>
+inline void JPrimitiveArrayRegion<jlongArray, jlong, 8>::get_region(JNIEnv* env, jlongArray jarray, jsize size,
+                                                                     jlong* buf)
+{
+    env->GetLongArrayRegion(jarray, 0, size, buf);
+}
+
+// Copies a Java byte[] into an OwnedBinaryData with a single GetByteArrayRegion call. A null array gives a null
+// OwnedBinaryData.
+inline OwnedBinaryData to_owned_binary_data(JNIEnv* env, jbyteArray jarray)
+{
+    if (!jarray) {
+        return OwnedBinaryData();
+    }
+
+    // To solve the link issue by directly using Table::max_binary_size
+    static constexpr size_t max_binary_size = Table::max_binary_size;
+
+    jsize size = env->GetArrayLength(jarray);
+    if (static_cast<size_t>(size) > max_binary_size) {
+        THROW_JAVA_EXCEPTION(env, JavaExceptionDef::IllegalArgument,
+                             util::format("The length of 'byte[]' value is %1 which exceeds the max binary size %2.",
+                                          size, max_binary_size));
+    }
+    std::unique_ptr<char[]> buf(new char[size]);
+    env->GetByteArrayRegion(jarray, 0, size, reinterpret_cast<jbyte*>(buf.get()));
+    return OwnedBinaryData(std::move(buf), static_cast<size_t>(size));
+}
+
 template <>
 inline bool JavaAccessorContext::unbox(util::Any& v, bool, bool) const
 {
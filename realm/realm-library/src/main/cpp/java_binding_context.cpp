@@ -58,6 +58,8 @@ void JavaBindingContext::did_change(std::vector<BindingContext::ObserverState> c
 
 void JavaBindingContext::schema_did_change(Schema const&)
 {
+    // The cached classes point into the old schema.
+    m_schema_cache.clear();
     if (!m_schema_changed_callback) {
         return;
     }
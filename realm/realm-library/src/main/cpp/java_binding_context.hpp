@@ -22,6 +22,7 @@
 
 #include "binding_context.hpp"
 
+#include "schema_cache.hpp"
 #include "jni_util/java_global_weak_ref.hpp"
 
 namespace realm {
@@ -39,6 +40,7 @@ private:
     // Java should hold a strong ref to them as long as the SharedRealm lives
     jni_util::JavaGlobalWeakRef m_java_notifier;
     jni_util::JavaGlobalWeakRef m_schema_changed_callback;
+    SchemaCache m_schema_cache;
 
 public:
     virtual ~JavaBindingContext(){};
@@ -60,6 +62,11 @@ public:
 
     void set_schema_changed_callback(JNIEnv* env, jobject schema_changed_callback);
 
+    SchemaCache& schema_cache() noexcept
+    {
+        return m_schema_cache;
+    }
+
     static inline std::unique_ptr<JavaBindingContext> create(JNIEnv* env, jobject notifier)
     {
         return std::make_unique<JavaBindingContext>(ConcreteJavaBindContext{env, notifier});
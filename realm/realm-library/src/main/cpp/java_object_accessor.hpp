@@ -21,12 +21,14 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <stdexcept>
 #include <type_traits>
 
 #include "java_accessor.hpp"
 #include "java_class_global_def.hpp"
 #include "object_accessor.hpp"
 #include "object-store/src/property.hpp"
+#include "schema_cache.hpp"
 
 #include <realm/row.hpp>
 #include <realm/util/any.hpp>
@@ -51,6 +53,7 @@ struct JavaValue;
 
 enum class JavaValueType {
     Empty,
+    Missing,
 #define REALM_DEFINE_JAVA_VALUE_TYPE(x) x,
     REALM_FOR_EACH_JAVA_VALUE_TYPE(REALM_DEFINE_JAVA_VALUE_TYPE)
 #undef REALM_DEFINE_JAVA_VALUE_TYPE
@@ -66,18 +69,48 @@ template <class T, class... Rest> constexpr T realm_max(T a, T b, Rest... rest)
     return a > realm_max(b, rest...) ? a : realm_max(b, rest...);
 }
 
+// View of an array of JavaValues. The array is owned by the JavaObjectData (or the caller) the value comes from.
+class JavaValueList {
+public:
+    JavaValueList() noexcept = default;
+    JavaValueList(const JavaValue* data, size_t size) noexcept
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    const JavaValue* begin() const noexcept
+    {
+        return m_data;
+    }
+    const JavaValue* end() const noexcept;
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+    const JavaValue& at(size_t index) const;
+
+private:
+    const JavaValue* m_data = nullptr;
+    size_t m_size = 0;
+};
+
 template <JavaValueType> struct JavaValueTypeRepr;
 template <> struct JavaValueTypeRepr<JavaValueType::Integer> { using Type = jlong; };
-template <> struct JavaValueTypeRepr<JavaValueType::String>  { using Type = std::string; };
+template <> struct JavaValueTypeRepr<JavaValueType::String>  { using Type = StringData; };
 template <> struct JavaValueTypeRepr<JavaValueType::Boolean> { using Type = jboolean; };
 template <> struct JavaValueTypeRepr<JavaValueType::Float>   { using Type = jfloat; };
 template <> struct JavaValueTypeRepr<JavaValueType::Double>  { using Type = jdouble; };
 template <> struct JavaValueTypeRepr<JavaValueType::Date>    { using Type = Timestamp; };
-template <> struct JavaValueTypeRepr<JavaValueType::Binary>  { using Type = OwnedBinaryData; };
+template <> struct JavaValueTypeRepr<JavaValueType::Binary>  { using Type = BinaryData; };
 template <> struct JavaValueTypeRepr<JavaValueType::Object>  { using Type = RowExpr*; };
-template <> struct JavaValueTypeRepr<JavaValueType::List>    { using Type = std::vector<JavaValue>; };
+template <> struct JavaValueTypeRepr<JavaValueType::List>    { using Type = JavaValueList; };
 
-// Tagged union class representing all the values Java can send to Object Store
+// Tagged union class representing all the values Java can send to Object Store.
+//
+// Strings, binaries and lists are only views. The memory they point to must outlive the value, which is normally
+// ensured by storing it in the JavaValueArena of the JavaObjectData the value belongs to (see java_object_data.hpp).
+// All representations are trivially destructible, so values can be copied freely and never need to be destroyed.
 struct JavaValue {
     using Storage = std::aligned_storage_t<realm_max(
 #define REALM_GET_SIZE_OF_JAVA_VALUE_TYPE_REPR(x) \
@@ -93,75 +126,46 @@ struct JavaValue {
 #undef REALM_GET_ALIGN_OF_JAVA_VALUE_TYPE_REPR
         )>;
 
+#define REALM_CHECK_JAVA_VALUE_TYPE_REPR(x) \
+    static_assert(std::is_trivially_destructible<JavaValueTypeRepr<JavaValueType::x>::Type>::value, \
+                  "The representation of JavaValueType::" #x " must not own any memory.");
+    REALM_FOR_EACH_JAVA_VALUE_TYPE(REALM_CHECK_JAVA_VALUE_TYPE_REPR)
+#undef REALM_CHECK_JAVA_VALUE_TYPE_REPR
+
     Storage m_storage;
     JavaValueType m_type;
 
     // Initializer constructors
     JavaValue() : m_type(JavaValueType::Empty) {}
 
+    // A value which is not given at all, as opposed to a null value. Missing properties keep their current value when
+    // updating an object and get the default value of their column when creating one.
+    static JavaValue missing() noexcept
+    {
+        JavaValue value;
+        value.m_type = JavaValueType::Missing;
+        return value;
+    }
+
 #define REALM_DEFINE_JAVA_VALUE_TYPE_CONSTRUCTOR(x) \
     explicit JavaValue(JavaValueTypeRepr<JavaValueType::x>::Type value) : m_type(JavaValueType::x) \
     { \
-        new(&m_storage) JavaValueTypeRepr<JavaValueType::x>::Type{std::move(value)}; \
+        new(&m_storage) JavaValueTypeRepr<JavaValueType::x>::Type{value}; \
     }
     REALM_FOR_EACH_JAVA_VALUE_TYPE(REALM_DEFINE_JAVA_VALUE_TYPE_CONSTRUCTOR)
 #undef REALM_DEFINE_JAVA_VALUE_TYPE_CONSTRUCTOR
 
-    // Copy constructors
-    JavaValue(const JavaValue& jvt) : m_type(JavaValueType::Empty) {
-        *this = jvt;
-    }
-
-    // Move constructor
-    JavaValue(JavaValue&& jvt) : m_type(JavaValueType::Empty) {
-        *this = std::move(jvt);
-    }
-
-    ~JavaValue()
-    {
-        clear();
-    }
-
-    JavaValue& operator=(const JavaValue& rhs)
-    {
-       clear();
-       switch (rhs.m_type) {
-#define REALM_DEFINE_JAVA_VALUE_COPY_ASSIGNMENT(x) \
-           case JavaValueType::x: { \
-               using T = JavaValueTypeRepr<JavaValueType::x>::Type; \
-               new(&m_storage) T{*reinterpret_cast<const T*>(&rhs.m_storage)}; \
-               break; \
-           }
-        REALM_FOR_EACH_JAVA_VALUE_TYPE(REALM_DEFINE_JAVA_VALUE_COPY_ASSIGNMENT)
-#undef REALM_DEFINE_JAVA_VALUE_COPY_ASSIGNMENT
-           default: REALM_ASSERT(rhs.m_type == JavaValueType::Empty);
-        }
-        m_type = rhs.m_type;
-        return *this;
-    }
+    JavaValue(const JavaValue&) = default;
+    JavaValue& operator=(const JavaValue&) = default;
 
-    JavaValue& operator=(JavaValue&& rhs)
+    bool has_value() const noexcept
     {
-       clear();
-       switch (rhs.m_type) {
-           case JavaValueType::Empty: break; // Do nothing
-#define REALM_DEFINE_JAVA_VALUE_COPY_ASSIGNMENT(x) \
-           case JavaValueType::x: { \
-               using T = JavaValueTypeRepr<JavaValueType::x>::Type; \
-               new(&m_storage) T{std::move(*reinterpret_cast<T*>(&rhs.m_storage))}; \
-               break; \
-           }
-        REALM_FOR_EACH_JAVA_VALUE_TYPE(REALM_DEFINE_JAVA_VALUE_COPY_ASSIGNMENT)
-#undef REALM_DEFINE_JAVA_VALUE_COPY_ASSIGNMENT
-           default: REALM_TERMINATE("Invalid type");
-        }
-        m_type = rhs.m_type;
-        return *this;
+        return m_type != JavaValueType::Empty && m_type != JavaValueType::Missing;
     }
 
-    bool has_value() const noexcept
+    bool is_missing() const noexcept
     {
-        return m_type != JavaValueType::Empty;
+        return m_type == JavaValueType::Missing;
     }
 
     JavaValueType get_type() const noexcept
@@ -223,18 +227,6 @@ struct JavaValue {
 
     void clear() noexcept
     {
-        switch (m_type) {
-            case JavaValueType::Empty: break; // Do nothing
-#define REALM_DEFINE_JAVA_VALUE_DESTROY(x) \
-            case JavaValueType::x: { \
-                using T = JavaValueTypeRepr<JavaValueType::x>::Type; \
-                reinterpret_cast<T*>(&m_storage)->~T(); \
-                break; \
-            }
-            REALM_FOR_EACH_JAVA_VALUE_TYPE(REALM_DEFINE_JAVA_VALUE_DESTROY)
-#undef REALM_DEFINE_JAVA_VALUE_DESTROY
-            default: REALM_TERMINATE("Invalid type.");
-        }
         m_type = JavaValueType::Empty;
     }
 
@@ -244,11 +236,13 @@ struct JavaValue {
         switch(m_type) {
             case JavaValueType::Empty:
                 return "null";
+            case JavaValueType::Missing:
+                return "missing";
             case JavaValueType::Integer:
                 ss << static_cast<int64_t>(get_int());
                 return std::string(ss.str());
             case JavaValueType::String:
-                return get_string();
+                return std::string(get_string());
             case JavaValueType::Boolean:
                 return (get_boolean() == JNI_TRUE) ? "true" : "false";
             case JavaValueType::Float:
@@ -282,6 +276,19 @@ struct JavaValue {
     }
 };
 
+inline const JavaValue* JavaValueList::end() const noexcept
+{
+    return m_data + m_size;
+}
+
+inline const JavaValue& JavaValueList::at(size_t index) const
+{
+    if (index >= m_size) {
+        throw std::out_of_range(util::format("Index %1 is out of range, the list has %2 values.", index, m_size));
+    }
+    return m_data[index];
+}
+
 
 struct RequiredFieldValueNotProvidedException : public std::logic_error {
     const std::string object_type;
@@ -307,7 +314,7 @@ public:
     JavaContext(JavaContext& c, Property const& prop)
             : m_env(c.m_env),
               realm(c.realm)
-            , object_schema(prop.type == PropertyType::Object ? &*realm->schema().find(prop.object_type) : c.object_schema)
+            , object_schema(prop.type == PropertyType::Object ? &link_target(realm, prop) : c.object_schema)
     { }
 
     // The use of util::Optional for the following two functions is not a hard
@@ -323,21 +330,49 @@ public:
                                                  Property const& prop,
                                                  size_t /*property_index*/) const
     {
-        const std::vector<JavaValue>& list = dict.get_list();
-        auto property_value = list.at(prop.table_column);
-        return util::make_optional(property_value);
+        // Values are views, so this doesn't copy the data of strings, binaries or lists.
+        const JavaValue& value = dict.get_list().at(prop.table_column);
+        if (value.is_missing()) {
+            return util::none;
+        }
+        return util::make_optional(value);
     }
 
     // Get the default value for the given property in the given object schema,
     // or `util::none` if there is none (which is distinct from the default
     // being `null`).
     //
-    // This implementation does not support default values; see the default
-    // value tests for an example of one which does.
+    // This is only asked for values which are missing (see JavaValue::missing()),
+    // e.g. properties not found in imported JSON. New objects get the default
+    // value of the column then, same as objects created by Realm.createObject().
+    // There is no default for primary keys, nullable properties and lists.
     util::Optional<JavaValue>
-    default_value_for_property(ObjectSchema const&, Property const&) const
+    default_value_for_property(ObjectSchema const&, Property const& prop) const
     {
-        return util::none;
+        // Empty strings and binaries must not be confused with null ones.
+        static const char empty_data[] = "";
+
+        if (prop.is_primary || is_nullable(prop.type) || is_array(prop.type)) {
+            return util::none;
+        }
+        switch (prop.type & ~PropertyType::Flags) {
+            case PropertyType::Int:
+                return JavaValue(static_cast<jlong>(0));
+            case PropertyType::Bool:
+                return JavaValue(static_cast<jboolean>(JNI_FALSE));
+            case PropertyType::Float:
+                return JavaValue(static_cast<jfloat>(0));
+            case PropertyType::Double:
+                return JavaValue(static_cast<jdouble>(0));
+            case PropertyType::String:
+                return JavaValue(StringData(empty_data, 0));
+            case PropertyType::Data:
+                return JavaValue(BinaryData(empty_data, 0));
+            case PropertyType::Date:
+                return JavaValue(Timestamp(0, 0));
+            default:
+                return util::none;
+        }
     }
 
     // Invoke `fn` with each of the values from an enumerable type
@@ -476,7 +511,7 @@ inline BinaryData JavaContext::unbox(JavaValue const& v, bool, bool, bool, size_
     if (!v.has_value()) {
         return BinaryData();
     } else {
-        return v.get_binary().get();
+        return v.get_binary();
     }
 }
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "java_object_batch.hpp"
+
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+namespace {
+
+const char* type_name(JavaValueType type)
+{
+    switch (type) {
+#define REALM_JAVA_VALUE_TYPE_NAME(x)                                                                                \
+    case JavaValueType::x:                                                                                           \
+        return #x;
+        REALM_FOR_EACH_JAVA_VALUE_TYPE(REALM_JAVA_VALUE_TYPE_NAME)
+#undef REALM_JAVA_VALUE_TYPE_NAME
+        default:
+            return "Empty";
+    }
+}
+
+// The property type a non-null value of the given type can be stored in.
+PropertyType property_type_for(JavaValueType type)
+{
+    switch (type) {
+        case JavaValueType::Integer:
+            return PropertyType::Int;
+        case JavaValueType::String:
+            return PropertyType::String;
+        case JavaValueType::Boolean:
+            return PropertyType::Bool;
+        case JavaValueType::Float:
+            return PropertyType::Float;
+        case JavaValueType::Double:
+            return PropertyType::Double;
+        case JavaValueType::Date:
+            return PropertyType::Date;
+        case JavaValueType::Binary:
+            return PropertyType::Data;
+        case JavaValueType::Object:
+            return PropertyType::Object;
+        default:
+            REALM_UNREACHABLE();
+    }
+}
+
+void validate_value(const ObjectSchema& object_schema, const Property& property, const JavaValue& value,
+                    bool in_list)
+{
+    PropertyType base_type = property.type & ~PropertyType::Flags;
+    if (!value.has_value()) {
+        // Links are nullable, the items of a list of links are not.
+        if (!is_nullable(property.type)) {
+            throw std::invalid_argument(util::format("Property '%1.%2' cannot be null%3.", object_schema.name,
+                                                     property.name, in_list ? " in a list" : ""));
+        }
+        return;
+    }
+    if (property_type_for(value.get_type()) != base_type) {
+        throw std::invalid_argument(util::format("Property '%1.%2' of type '%3' cannot be set to a %4 value.",
+                                                 object_schema.name, property.name,
+                                                 string_for_property_type(base_type), type_name(value.get_type())));
+    }
+}
+
+} // anonymous namespace
+
+const ObjectSchema& realm::_impl::object_schema_for_table(const Schema& schema, const Table& table)
+{
+    std::string table_name(table.get_name());
+    std::string class_name = table_name.substr(TABLE_PREFIX.length());
+    auto it = schema.find(class_name);
+    if (it == schema.end()) {
+        throw std::runtime_error(util::format("Class '%1' cannot be found in the schema.", class_name));
+    }
+    return *it;
+}
+
+void realm::_impl::validate_property_value(const ObjectSchema& object_schema, const Property& property,
+                                           const JavaValue& value)
+{
+    if (!is_array(property.type)) {
+        if (value.get_type() == JavaValueType::List) {
+            throw std::invalid_argument(
+                util::format("Property '%1.%2' is not a list.", object_schema.name, property.name));
+        }
+        validate_value(object_schema, property, value, false);
+    }
+    else if (value.get_type() == JavaValueType::List) {
+        for (const JavaValue& item : value.get_list()) {
+            validate_value(object_schema, property, item, true);
+        }
+    }
+    else if (value.has_value()) {
+        throw std::invalid_argument(util::format("Property '%1.%2' is a list.", object_schema.name, property.name));
+    }
+}
+
+void realm::_impl::validate_object_values(const ObjectSchema& object_schema, const JavaValue* values,
+                                          size_t column_count)
+{
+    for (const Property& property : object_schema.persisted_properties) {
+        if (property.table_column < column_count) {
+            validate_property_value(object_schema, property, values[property.table_column]);
+        }
+    }
+}
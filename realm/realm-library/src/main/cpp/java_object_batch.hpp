@@ -0,0 +1,109 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef REALM_JNI_IMPL_JAVA_OBJECT_BATCH_HPP
+#define REALM_JNI_IMPL_JAVA_OBJECT_BATCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <object_schema.hpp>
+#include <schema.hpp>
+
+#include "java_object_data.hpp"
+
+namespace realm {
+namespace _impl {
+
+// A batch of decoded objects of the same class, ready to be passed to Object::create(). The values of all objects are
+// stored back to back in a single vector and their strings, binaries and lists in a single arena, so preparing a
+// batch costs a handful of allocations no matter how many objects it holds.
+//
+// A batch doesn't reference the Realm and can be prepared on any thread. Only the links (row pointers) it might
+// contain are bound to the thread of the Realm they come from.
+class JavaObjectBatch {
+public:
+    explicit JavaObjectBatch(size_t column_count)
+        : m_column_count(column_count)
+    {
+    }
+
+    JavaObjectBatch(JavaObjectBatch&&) = default;
+    JavaObjectBatch& operator=(JavaObjectBatch&&) = default;
+    JavaObjectBatch(const JavaObjectBatch&) = delete;
+    JavaObjectBatch& operator=(const JavaObjectBatch&) = delete;
+
+    // Appends an object with all columns empty and returns its column_count() values. The pointer is only valid until
+    // the next object is added.
+    JavaValue* add_object()
+    {
+        m_values.resize(m_values.size() + m_column_count);
+        ++m_object_count;
+        return m_values.data() + m_values.size() - m_column_count;
+    }
+
+    size_t size() const noexcept
+    {
+        return m_object_count;
+    }
+
+    size_t column_count() const noexcept
+    {
+        return m_column_count;
+    }
+
+    // The object at the given index as a list of its column values, see JavaObjectData::as_value().
+    JavaValue object_at(size_t index) const noexcept
+    {
+        return JavaValue(JavaValueList(m_values.data() + index * m_column_count, m_column_count));
+    }
+
+    JavaValueArena& arena() noexcept
+    {
+        return m_arena;
+    }
+
+    // Estimation of the memory held, used by NativeObjectStats.
+    size_t estimated_size() const noexcept
+    {
+        return sizeof(JavaObjectBatch) + m_values.capacity() * sizeof(JavaValue) + m_arena.capacity();
+    }
+
+private:
+    size_t m_column_count;
+    size_t m_object_count = 0;
+    std::vector<JavaValue> m_values;
+    JavaValueArena m_arena;
+};
+
+// Returns the schema of the class stored in the given table. Throws if the class is not part of the schema.
+const ObjectSchema& object_schema_for_table(const Schema& schema, const Table& table);
+
+// Checks a value against the type of its property. Lists are only accepted for list properties, where every item is
+// checked. Throws std::invalid_argument if the value doesn't match.
+void validate_property_value(const ObjectSchema& object_schema, const Property& property, const JavaValue& value);
+
+// Checks the decoded values of an object against the schema of its class: the type of every value must match the
+// type of its property, and null is only accepted for nullable properties, lists and links. Unset columns are treated
+// as null since the decoded values cannot tell them apart. Doing this when the values are decoded reports errors
+// before the write transaction is needed. Throws std::invalid_argument if a value doesn't match.
+void validate_object_values(const ObjectSchema& object_schema, const JavaValue* values, size_t column_count);
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_JAVA_OBJECT_BATCH_HPP
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_JAVA_OBJECT_DATA_HPP
+#define REALM_JNI_IMPL_JAVA_OBJECT_DATA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "java_object_accessor.hpp"
+
+namespace realm {
+namespace _impl {
+
+// Bump allocator for the strings, binaries and lists referenced by the JavaValues of an object being built. Memory is
+// only given back when the arena is reset or destroyed, which makes each allocation a pointer increment in the common
+// case. Blocks are kept when the arena is reset, so building a batch of objects stops allocating after the first few.
+class JavaValueArena {
+public:
+    JavaValueArena() = default;
+    JavaValueArena(JavaValueArena&&) = default;
+    JavaValueArena& operator=(JavaValueArena&&) = default;
+    JavaValueArena(const JavaValueArena&) = delete;
+    JavaValueArena& operator=(const JavaValueArena&) = delete;
+
+    // Returns uninitialized memory for size bytes. alignment must be a power of two.
+    char* allocate(size_t size, size_t alignment = 1)
+    {
+        char* ptr = align(m_pos, alignment);
+        if (!ptr || ptr + size > m_end) {
+            ptr = next_block(size, alignment);
+        }
+        m_pos = ptr + size;
+        return ptr;
+    }
+
+    // Gives back the end of the last allocation, which must have started at ptr. Used when the exact size is only
+    // known after the data has been written, e.g. when transcoding a string.
+    void shrink_last(char* ptr, size_t new_size) noexcept
+    {
+        REALM_ASSERT_DEBUG(ptr + new_size <= m_pos);
+        m_pos = ptr + new_size;
+    }
+
+    // Returns uninitialized memory for count objects of type T.
+    template <typename T>
+    T* allocate_array(size_t count)
+    {
+        return reinterpret_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Makes all the memory available again. Everything allocated before is invalidated.
+    void reset() noexcept
+    {
+        m_current_block = 0;
+        m_pos = m_blocks.empty() ? nullptr : m_blocks.front().data.get();
+        m_end = m_blocks.empty() ? nullptr : m_pos + m_blocks.front().size;
+    }
+
+    // Total size of the blocks held by the arena.
+    size_t capacity() const noexcept
+    {
+        size_t total = 0;
+        for (auto& block : m_blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+private:
+    static constexpr size_t min_block_size = 4096;
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> m_blocks;
+    size_t m_current_block = 0;
+    char* m_pos = nullptr;
+    char* m_end = nullptr;
+
+    static char* align(char* ptr, size_t alignment) noexcept
+    {
+        auto value = reinterpret_cast<uintptr_t>(ptr);
+        return reinterpret_cast<char*>((value + alignment - 1) & ~(uintptr_t(alignment) - 1));
+    }
+
+    char* next_block(size_t size, size_t alignment)
+    {
+        size_t required = size + alignment - 1;
+        // Reuse the blocks kept by reset() before allocating a new one.
+        size_t index = m_blocks.empty() ? 0 : m_current_block + 1;
+        while (index < m_blocks.size() && m_blocks[index].size < required) {
+            ++index;
+        }
+        if (index == m_blocks.size()) {
+            size_t block_size = std::max(required, m_blocks.empty() ? min_block_size : m_blocks.back().size * 2);
+            m_blocks.push_back({std::unique_ptr<char[]>(new char[block_size]), block_size});
+        }
+        m_current_block = index;
+        Block& block = m_blocks[index];
+        m_end = block.data.get() + block.size;
+        return align(block.data.get(), alignment);
+    }
+};
+
+// The values of an object being built by OsObjectBuilder, together with the arena holding their data. The values
+// are indexed by column. It is move-only, so the data is written once and never copied on its way to
+// Object::create().
+class JavaObjectData {
+public:
+    explicit JavaObjectData(size_t column_count)
+        : m_values(column_count)
+    {
+    }
+
+    JavaObjectData(JavaObjectData&&) = default;
+    JavaObjectData& operator=(JavaObjectData&&) = default;
+    JavaObjectData(const JavaObjectData&) = delete;
+    JavaObjectData& operator=(const JavaObjectData&) = delete;
+
+    std::vector<JavaValue>& values() noexcept
+    {
+        return m_values;
+    }
+
+    const std::vector<JavaValue>& values() const noexcept
+    {
+        return m_values;
+    }
+
+    JavaValueArena& arena() noexcept
+    {
+        return m_arena;
+    }
+
+    // The object as a list of its column values, which is how Object::create() expects to receive it through
+    // JavaContext. Only valid as long as this object is alive.
+    JavaValue as_value() const noexcept
+    {
+        return JavaValue(JavaValueList(m_values.data(), m_values.size()));
+    }
+
+    // Sets all values to the given one (null by default) and reuses the arena for the next object.
+    void reset(const JavaValue& value = JavaValue()) noexcept
+    {
+        std::fill(m_values.begin(), m_values.end(), value);
+        m_arena.reset();
+    }
+
+    // Estimation of the memory held, used by NativeObjectStats.
+    size_t estimated_size() const noexcept
+    {
+        return sizeof(JavaObjectData) + m_values.capacity() * sizeof(JavaValue) + m_arena.capacity();
+    }
+
+private:
+    JavaValueArena m_arena;
+    std::vector<JavaValue> m_values;
+};
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_JAVA_OBJECT_DATA_HPP
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "java_object_data_reader.hpp"
+
+#include "io_realm_internal_objectstore_ObjectDataBuffer.h"
+#include "util.hpp"
+
+#include <realm/util/to_string.hpp>
+
+using namespace realm;
+using namespace realm::_impl;
+
+#define REALM_CHECK_OBJECT_DATA_TYPE(type, java_type)                                                                \
+    static_assert(static_cast<int>(JavaObjectDataReader::Type::type) ==                                              \
+                      io_realm_internal_objectstore_ObjectDataBuffer_##java_type,                                    \
+                  "JavaObjectDataReader::Type::" #type " doesn't match ObjectDataBuffer." #java_type)
+
+REALM_CHECK_OBJECT_DATA_TYPE(Null, TYPE_NULL);
+REALM_CHECK_OBJECT_DATA_TYPE(Integer, TYPE_INTEGER);
+REALM_CHECK_OBJECT_DATA_TYPE(Boolean, TYPE_BOOLEAN);
+REALM_CHECK_OBJECT_DATA_TYPE(Float, TYPE_FLOAT);
+REALM_CHECK_OBJECT_DATA_TYPE(Double, TYPE_DOUBLE);
+REALM_CHECK_OBJECT_DATA_TYPE(Date, TYPE_DATE);
+REALM_CHECK_OBJECT_DATA_TYPE(String, TYPE_STRING);
+REALM_CHECK_OBJECT_DATA_TYPE(Binary, TYPE_BINARY);
+REALM_CHECK_OBJECT_DATA_TYPE(Object, TYPE_OBJECT);
+REALM_CHECK_OBJECT_DATA_TYPE(List, TYPE_LIST);
+
+#undef REALM_CHECK_OBJECT_DATA_TYPE
+
+static_assert(JavaObjectDataReader::end_of_object == io_realm_internal_objectstore_ObjectDataBuffer_END_OF_OBJECT,
+              "JavaObjectDataReader::end_of_object doesn't match ObjectDataBuffer.END_OF_OBJECT");
+
+JavaObjectDataReader::JavaObjectDataReader(JNIEnv* env, jobject byte_buffer, jlong size)
+{
+    auto begin = static_cast<const char*>(env->GetDirectBufferAddress(byte_buffer));
+    if (!begin) {
+        throw std::invalid_argument("The object data is not stored in a direct ByteBuffer.");
+    }
+    if (size < 0 || size > env->GetDirectBufferCapacity(byte_buffer)) {
+        throw std::invalid_argument(util::format("Invalid object data size %1.", size));
+    }
+    m_pos = begin;
+    m_end = begin + size;
+}
+
+void JavaObjectDataReader::check_available(size_t size) const
+{
+    if (static_cast<size_t>(m_end - m_pos) < size) {
+        throw std::invalid_argument("Unexpected end of the object data.");
+    }
+}
+
+size_t JavaObjectDataReader::read_size()
+{
+    int32_t size = read<int32_t>();
+    if (size < 0) {
+        throw std::invalid_argument(util::format("Invalid size %1 in the object data.", size));
+    }
+    return static_cast<size_t>(size);
+}
+
+void JavaObjectDataReader::read_object(JavaValue* values, size_t column_count, JavaValueArena& arena)
+{
+    for (int32_t column_index = read<int32_t>(); column_index != end_of_object; column_index = read<int32_t>()) {
+        if (column_index < 0 || static_cast<size_t>(column_index) >= column_count) {
+            throw std::invalid_argument(util::format("Invalid column index %1 in the object data.", column_index));
+        }
+        values[column_index] = read_value(arena, true);
+    }
+}
+
+JavaValue JavaObjectDataReader::read_value(JavaValueArena& arena, bool allow_list)
+{
+    // Empty strings and binaries must not be confused with null ones.
+    static const char empty_data[] = "";
+
+    auto type = static_cast<Type>(read<int8_t>());
+    switch (type) {
+        case Type::Null:
+            return JavaValue();
+        case Type::Integer:
+            return JavaValue(static_cast<jlong>(read<int64_t>()));
+        case Type::Boolean:
+            return JavaValue(static_cast<jboolean>(read<int8_t>() ? JNI_TRUE : JNI_FALSE));
+        case Type::Float:
+            return JavaValue(static_cast<jfloat>(read<float>()));
+        case Type::Double:
+            return JavaValue(static_cast<jdouble>(read<double>()));
+        case Type::Date:
+            return JavaValue(from_milliseconds(read<int64_t>()));
+        case Type::String: {
+            size_t length = read_size();
+            check_available(length * sizeof(jchar));
+            if (length == 0) {
+                return JavaValue(StringData(empty_data, 0));
+            }
+            const char* chars = m_pos;
+            m_pos += length * sizeof(jchar);
+            char* out = arena.allocate(max_utf8_size(length));
+            size_t size;
+            if (reinterpret_cast<uintptr_t>(chars) % alignof(jchar) == 0) {
+                size = to_utf8(reinterpret_cast<const jchar*>(chars), length, out);
+            }
+            else {
+                // The code units are not aligned, copy them into the arena first.
+                jchar* aligned_chars = arena.allocate_array<jchar>(length);
+                std::memcpy(aligned_chars, chars, length * sizeof(jchar));
+                // The output must stay the last allocation to be able to shrink it.
+                out = arena.allocate(max_utf8_size(length));
+                size = to_utf8(aligned_chars, length, out);
+            }
+            arena.shrink_last(out, size);
+            return JavaValue(StringData(out, size));
+        }
+        case Type::Binary: {
+            size_t size = read_size();
+            check_available(size);
+            if (size == 0) {
+                return JavaValue(BinaryData(empty_data, 0));
+            }
+            char* data = arena.allocate(size);
+            std::memcpy(data, m_pos, size);
+            m_pos += size;
+            return JavaValue(BinaryData(data, size));
+        }
+        case Type::Object:
+            return JavaValue(reinterpret_cast<RowExpr*>(read<int64_t>()));
+        case Type::List: {
+            if (!allow_list) {
+                throw std::invalid_argument("Nested lists are not supported in the object data.");
+            }
+            size_t size = read_size();
+            // Every value takes at least one byte.
+            check_available(size);
+            JavaValue* list = arena.allocate_array<JavaValue>(size);
+            for (size_t i = 0; i < size; ++i) {
+                new (&list[i]) JavaValue(read_value(arena, false));
+            }
+            return JavaValue(JavaValueList(list, size));
+        }
+    }
+    throw std::invalid_argument(util::format("Invalid value type %1 in the object data.", static_cast<int>(type)));
+}
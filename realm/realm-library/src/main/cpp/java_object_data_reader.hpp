@@ -0,0 +1,94 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_JAVA_OBJECT_DATA_READER_HPP
+#define REALM_JNI_IMPL_JAVA_OBJECT_DATA_READER_HPP
+
+#include <jni.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "java_object_data.hpp"
+
+namespace realm {
+namespace _impl {
+
+// Decodes the object values serialized by io.realm.internal.objectstore.ObjectDataBuffer. All values are written in
+// the native byte order:
+//
+//   object := { column_index:int32 value } END_OF_OBJECT:int32
+//   value  := type:int8 payload
+//
+// The payload depends on the type: nothing for null, int64 for integers and dates (milliseconds since the epoch),
+// int8 for booleans, float32, float64, int32 length + UTF-16 code units for strings, int32 length + bytes for
+// binaries, int64 native row pointer for objects and int32 size + values for lists. Lists cannot be nested.
+//
+// A buffer can contain several objects of the same class written one after the other.
+class JavaObjectDataReader {
+public:
+    // Must be kept in sync with the TYPE_XXX constants in ObjectDataBuffer.java.
+    enum class Type : int8_t { Null = 0, Integer, Boolean, Float, Double, Date, String, Binary, Object, List };
+    static constexpr int32_t end_of_object = -1;
+
+    JavaObjectDataReader(const char* begin, const char* end)
+        : m_pos(begin)
+        , m_end(end)
+    {
+    }
+
+    // Reads from a direct ByteBuffer written up to the given size.
+    JavaObjectDataReader(JNIEnv* env, jobject byte_buffer, jlong size);
+
+    bool at_end() const noexcept
+    {
+        return m_pos == m_end;
+    }
+
+    // Decodes the next object into data. Strings, binaries and lists are copied into the arena of data, so the values
+    // stay valid after the buffer is released. Columns not present in the buffer are left untouched.
+    void read_object(JavaObjectData& data)
+    {
+        read_object(data.values().data(), data.values().size(), data.arena());
+    }
+
+    // Same as above, but decodes into column_count values allocating their data from the given arena.
+    void read_object(JavaValue* values, size_t column_count, JavaValueArena& arena);
+
+private:
+    const char* m_pos;
+    const char* m_end;
+
+    template <typename T>
+    T read()
+    {
+        check_available(sizeof(T));
+        T value;
+        std::memcpy(&value, m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+
+    void check_available(size_t size) const;
+    size_t read_size();
+    JavaValue read_value(JavaValueArena& arena, bool allow_list);
+};
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_JAVA_OBJECT_DATA_READER_HPP
@@ -55,14 +55,15 @@ public:
     realm::SortDescriptor sort_descriptor() const noexcept;
     realm::DistinctDescriptor distinct_descriptor() const noexcept;
 
-private:
-    JNIEnv* m_env;
-    jobject m_sort_desc_obj;
-
+    // The raw content of the descriptor, for callers which compare the values themselves.
     realm::Table* get_table_ptr() const noexcept;
     std::vector<std::vector<size_t>> get_column_indices() const noexcept;
     std::vector<bool> get_ascendings() const noexcept;
 
+private:
+    JNIEnv* m_env;
+    jobject m_sort_desc_obj;
+
     jni_util::JavaClass const& get_sort_desc_class() const noexcept;
 };
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "native_methods.hpp"
+#include "log.hpp"
+
+#include <sys/system_properties.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace realm {
+namespace jni_util {
+
+namespace {
+
+// The "!" prefix of the signature enables the fast native calling convention. It is only honoured by Dalvik and by
+// ART before Android 8.0 (API 26). Later versions ignore it and log a warning for every method, so only use it on the
+// versions which actually benefit from it.
+constexpr int fast_native_max_sdk = 25;
+
+int get_sdk_version()
+{
+    char value[PROP_VALUE_MAX] = {0};
+    if (__system_property_get("ro.build.version.sdk", value) <= 0) {
+        return 0;
+    }
+    return std::atoi(value);
+}
+
+} // anonymous namespace
+
+void register_natives(JNIEnv* env)
+{
+    const bool use_fast_natives = get_sdk_version() <= fast_native_max_sdk;
+
+    std::vector<JNINativeMethod> methods;
+    std::vector<std::string> fast_signatures;
+    for (size_t i = 0; i < g_native_classes_count; ++i) {
+        const NativeClass& native_class = g_native_classes[i];
+        methods.clear();
+        fast_signatures.clear();
+        // Keep the pointers to the prefixed signatures stable.
+        fast_signatures.reserve(native_class.count);
+
+        for (size_t j = 0; j < native_class.count; ++j) {
+            const NativeMethod& method = native_class.methods[j];
+            if (!method.fn_ptr) {
+                continue;
+            }
+            const char* signature = method.signature;
+            if (use_fast_natives && method.fast) {
+                fast_signatures.push_back(std::string("!") + method.signature);
+                signature = fast_signatures.back().c_str();
+            }
+            methods.push_back({const_cast<char*>(method.name), const_cast<char*>(signature), method.fn_ptr});
+        }
+        if (methods.empty()) {
+            continue;
+        }
+
+        jclass cls = env->FindClass(native_class.class_name);
+        if (!cls) {
+            env->ExceptionClear();
+            Log::w("Cannot find class '%1' to register its native methods.", native_class.class_name);
+            continue;
+        }
+        if (env->RegisterNatives(cls, methods.data(), static_cast<jint>(methods.size())) != JNI_OK) {
+            env->ExceptionClear();
+            Log::w("Failed to register the native methods of '%1'. They will be resolved by symbol lookup.",
+                   native_class.class_name);
+        }
+        env->DeleteLocalRef(cls);
+    }
+}
+
+} // namespace jni_util
+} // namespace realm
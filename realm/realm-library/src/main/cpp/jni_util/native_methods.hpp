@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_UTIL_NATIVE_METHODS_HPP
+#define REALM_JNI_UTIL_NATIVE_METHODS_HPP
+
+#include <jni.h>
+
+#include <cstddef>
+
+namespace realm {
+namespace jni_util {
+
+// Describes one native method of a Java class. The tables are generated from the javah headers at build time by
+// CMake/GenerateJniRegistration.cmake, so they always match the Java declarations.
+struct NativeMethod {
+    const char* name;
+    const char* signature;
+    // nullptr if the native is declared in Java but not implemented in this build (e.g. sync natives).
+    void* fn_ptr;
+    // Hot and trivial natives which never call back into the VM. They are registered with the "!" signature prefix
+    // where the runtime supports it.
+    bool fast;
+};
+
+struct NativeClass {
+    // Class name in the JNI format, e.g. "io/realm/internal/OsResults".
+    const char* class_name;
+    const NativeMethod* methods;
+    size_t count;
+};
+
+extern const NativeClass g_native_classes[];
+extern const size_t g_native_classes_count;
+
+// Binds all the natives in g_native_classes with RegisterNatives(). This avoids the symbol lookup done by the VM on the
+// first call of every native and lets ART/Dalvik bind them directly. If the registration of a class fails, the error
+// is logged and the natives of that class are left to be resolved by their exported symbols.
+// Call this only once in JNI_OnLoad.
+void register_natives(JNIEnv* env);
+
+} // namespace jni_util
+} // namespace realm
+
+#endif // REALM_JNI_UTIL_NATIVE_METHODS_HPP
@@ -0,0 +1,432 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "json_object_exporter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+
+#include <unistd.h>
+
+#include <realm/link_view.hpp>
+#include <realm/table.hpp>
+
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+namespace {
+
+constexpr size_t chunk_size = 64 * 1024;
+
+void write_string(std::string& out, StringData value)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+
+    out += '"';
+    const char* data = value.data();
+    const char* end = data + value.size();
+    while (data != end) {
+        // Copy the characters which don't need escaping in one go.
+        const char* start = data;
+        while (data != end && *data != '"' && *data != '\\' && static_cast<unsigned char>(*data) >= 0x20) {
+            ++data;
+        }
+        out.append(start, data);
+        if (data == end) {
+            break;
+        }
+        char c = *data++;
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                out += "\\u00";
+                out += hex_digits[(c >> 4) & 0xF];
+                out += hex_digits[c & 0xF];
+                break;
+        }
+    }
+    out += '"';
+}
+
+void write_int(std::string& out, int64_t value)
+{
+    char buffer[24];
+    int size = std::snprintf(buffer, sizeof(buffer), "%" PRId64, value);
+    out.append(buffer, static_cast<size_t>(size));
+}
+
+// Uses the shortest of the two precisions which reads back to the same value, so 0.1 isn't written as
+// 0.10000000000000001.
+template <typename T>
+void write_floating_point(std::string& out, T value, int short_precision, int full_precision)
+{
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char buffer[32];
+    int size = std::snprintf(buffer, sizeof(buffer), "%.*g", short_precision, static_cast<double>(value));
+    if (static_cast<T>(std::strtod(buffer, nullptr)) != value) {
+        size = std::snprintf(buffer, sizeof(buffer), "%.*g", full_precision, static_cast<double>(value));
+    }
+    out.append(buffer, static_cast<size_t>(size));
+}
+
+void write_float(std::string& out, float value)
+{
+    write_floating_point(out, value, 6, 9);
+}
+
+void write_double(std::string& out, double value)
+{
+    write_floating_point(out, value, 15, 17);
+}
+
+void write_binary(std::string& out, BinaryData value)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    out += '"';
+    auto data = reinterpret_cast<const unsigned char*>(value.data());
+    size_t size = value.size();
+    size_t i = 0;
+    for (; i + 2 < size; i += 3) {
+        uint32_t bits = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        out += alphabet[(bits >> 18) & 0x3F];
+        out += alphabet[(bits >> 12) & 0x3F];
+        out += alphabet[(bits >> 6) & 0x3F];
+        out += alphabet[bits & 0x3F];
+    }
+    if (i < size) {
+        uint32_t bits = uint32_t(data[i]) << 16;
+        if (i + 1 < size) {
+            bits |= uint32_t(data[i + 1]) << 8;
+        }
+        out += alphabet[(bits >> 18) & 0x3F];
+        out += alphabet[(bits >> 12) & 0x3F];
+        out += i + 1 < size ? alphabet[(bits >> 6) & 0x3F] : '=';
+        out += '=';
+    }
+    out += '"';
+}
+
+// Converts days since 1970-01-01 to a date in the proleptic Gregorian calendar.
+void civil_from_days(int64_t days, int64_t& year, unsigned& month, unsigned& day)
+{
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned day_of_era = static_cast<unsigned>(days - era * 146097);
+    const unsigned year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const unsigned mp = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int64_t>(year_of_era) + era * 400 + (month <= 2);
+}
+
+// ISO 8601 in UTC with milliseconds, which is the precision of java.util.Date.
+void write_timestamp(std::string& out, Timestamp value)
+{
+    int64_t milliseconds = to_milliseconds(value);
+    int64_t days = milliseconds / 86400000;
+    int64_t millis_of_day = milliseconds % 86400000;
+    if (millis_of_day < 0) {
+        millis_of_day += 86400000;
+        --days;
+    }
+    int64_t year;
+    unsigned month, day;
+    civil_from_days(days, year, month, day);
+    char buffer[40];
+    int size = std::snprintf(buffer, sizeof(buffer), "\"%04" PRId64 "-%02u-%02uT%02d:%02d:%02d.%03dZ\"", year, month,
+                             day, static_cast<int>(millis_of_day / 3600000), static_cast<int>(millis_of_day / 60000 % 60),
+                             static_cast<int>(millis_of_day / 1000 % 60), static_cast<int>(millis_of_day % 1000));
+    out.append(buffer, static_cast<size_t>(size));
+}
+
+void write_all(int fd, const char* data, size_t size)
+{
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::system_category(), "Could not write the JSON output");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+} // anonymous namespace
+
+JsonObjectWriter::JsonObjectWriter(const Schema& schema, const ObjectSchema& object_schema,
+                                   const std::vector<std::string>& properties, size_t link_depth)
+    : m_schema(schema)
+    , m_link_depth(link_depth)
+{
+    const ClassInfo& info = class_info(object_schema.name);
+    if (properties.empty()) {
+        m_top_level = info;
+        return;
+    }
+    m_top_level.object_schema = info.object_schema;
+    for (const std::string& name : properties) {
+        const Property* property = info.object_schema->property_for_name(name);
+        if (!property || (property->type & ~PropertyType::Flags) == PropertyType::LinkingObjects) {
+            throw std::invalid_argument(
+                util::format("Property '%1' cannot be found in class '%2'.", name, object_schema.name));
+        }
+        m_top_level.properties.push_back(property);
+    }
+}
+
+const JsonObjectWriter::ClassInfo& JsonObjectWriter::class_info(const std::string& object_type)
+{
+    auto object_schema = m_schema.find(object_type);
+    REALM_ASSERT(object_schema != m_schema.end());
+    auto it = m_classes.find(&*object_schema);
+    if (it != m_classes.end()) {
+        return it->second;
+    }
+    ClassInfo& info = m_classes[&*object_schema];
+    info.object_schema = &*object_schema;
+    for (const Property& property : object_schema->persisted_properties) {
+        info.properties.push_back(&property);
+    }
+    return info;
+}
+
+void JsonObjectWriter::write_object(std::string& out, const ClassInfo& info, const Table& table, size_t row_index,
+                                    size_t depth)
+{
+    out += '{';
+    bool first = true;
+    for (const Property* property : info.properties) {
+        // Links beyond the depth are left out instead of being written as null, so they are not cleared when the
+        // JSON is imported again.
+        if ((property->type & ~PropertyType::Flags) == PropertyType::Object && depth >= m_link_depth) {
+            continue;
+        }
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        write_string(out, property->name);
+        out += ':';
+        if (is_array(property->type)) {
+            write_list(out, *property, table, row_index, depth);
+        }
+        else {
+            write_property(out, *property, table, row_index, depth);
+        }
+    }
+    out += '}';
+}
+
+void JsonObjectWriter::write_property(std::string& out, const Property& property, const Table& table,
+                                      size_t row_index, size_t depth)
+{
+    size_t col = property.table_column;
+    PropertyType type = property.type & ~PropertyType::Flags;
+    if (is_nullable(property.type) && type != PropertyType::Object && table.is_null(col, row_index)) {
+        out += "null";
+        return;
+    }
+    switch (type) {
+        case PropertyType::Int:
+            write_int(out, table.get_int(col, row_index));
+            return;
+        case PropertyType::Bool:
+            out += table.get_bool(col, row_index) ? "true" : "false";
+            return;
+        case PropertyType::Float:
+            write_float(out, table.get_float(col, row_index));
+            return;
+        case PropertyType::Double:
+            write_double(out, table.get_double(col, row_index));
+            return;
+        case PropertyType::String:
+            write_string(out, table.get_string(col, row_index));
+            return;
+        case PropertyType::Data:
+            write_binary(out, table.get_binary(col, row_index));
+            return;
+        case PropertyType::Date:
+            write_timestamp(out, table.get_timestamp(col, row_index));
+            return;
+        case PropertyType::Object: {
+            if (table.is_null_link(col, row_index)) {
+                out += "null";
+                return;
+            }
+            ConstTableRef target_table = table.get_link_target(col);
+            write_object(out, class_info(property.object_type), *target_table, table.get_link(col, row_index),
+                         depth + 1);
+            return;
+        }
+        default:
+            throw std::invalid_argument(util::format("Property '%1' of type '%2' cannot be exported to JSON.",
+                                                     property.name, string_for_property_type(property.type)));
+    }
+}
+
+void JsonObjectWriter::write_list(std::string& out, const Property& property, const Table& table, size_t row_index,
+                                  size_t depth)
+{
+    size_t col = property.table_column;
+    PropertyType type = property.type & ~PropertyType::Flags;
+    out += '[';
+    if (type == PropertyType::Object) {
+        ConstLinkViewRef link_view = table.get_linklist(col, row_index);
+        const ClassInfo& target_info = class_info(property.object_type);
+        const Table& target_table = link_view->get_target_table();
+        for (size_t i = 0; i < link_view->size(); ++i) {
+            if (i != 0) {
+                out += ',';
+            }
+            write_object(out, target_info, target_table, link_view->get(i).get_index(), depth + 1);
+        }
+        out += ']';
+        return;
+    }
+
+    // Lists of primitives are stored in a single column subtable.
+    ConstTableRef list = table.get_subtable(col, row_index);
+    size_t size = list ? list->size() : 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (i != 0) {
+            out += ',';
+        }
+        if (is_nullable(property.type) && list->is_null(0, i)) {
+            out += "null";
+            continue;
+        }
+        switch (type) {
+            case PropertyType::Int:
+                write_int(out, list->get_int(0, i));
+                break;
+            case PropertyType::Bool:
+                out += list->get_bool(0, i) ? "true" : "false";
+                break;
+            case PropertyType::Float:
+                write_float(out, list->get_float(0, i));
+                break;
+            case PropertyType::Double:
+                write_double(out, list->get_double(0, i));
+                break;
+            case PropertyType::String:
+                write_string(out, list->get_string(0, i));
+                break;
+            case PropertyType::Data:
+                write_binary(out, list->get_binary(0, i));
+                break;
+            case PropertyType::Date:
+                write_timestamp(out, list->get_timestamp(0, i));
+                break;
+            default:
+                throw std::invalid_argument(util::format("Property '%1' of type '%2' cannot be exported to JSON.",
+                                                         property.name, string_for_property_type(property.type)));
+        }
+    }
+    out += ']';
+}
+
+JsonResultsExporter::JsonResultsExporter(const Results& results, const std::vector<std::string>& properties,
+                                         size_t link_depth)
+    : m_results(results.snapshot())
+    , m_writer(results.get_realm()->schema(), results.get_object_schema(), properties, link_depth)
+{
+}
+
+bool JsonResultsExporter::render_more(size_t min_size)
+{
+    if (m_finished) {
+        return false;
+    }
+    // Everything before has been read, start over to keep the buffer small.
+    m_pending.clear();
+    m_pending_pos = 0;
+    if (!m_started) {
+        m_pending += '[';
+        m_started = true;
+    }
+    size_t size = m_results.size();
+    while (m_pending.size() < min_size && m_next_row < size) {
+        RowExpr row = m_results.get(m_next_row++);
+        if (!row.is_attached()) {
+            continue;
+        }
+        if (!m_first_object) {
+            m_pending += ',';
+        }
+        m_first_object = false;
+        m_writer.write_object(m_pending, *row.get_table(), row.get_index());
+    }
+    if (m_next_row == size) {
+        m_pending += ']';
+        m_finished = true;
+    }
+    return true;
+}
+
+size_t JsonResultsExporter::read(char* out, size_t size)
+{
+    size_t copied = 0;
+    while (copied < size) {
+        if (m_pending_pos == m_pending.size() && !render_more(size - copied)) {
+            break;
+        }
+        size_t count = std::min(size - copied, m_pending.size() - m_pending_pos);
+        std::memcpy(out + copied, m_pending.data() + m_pending_pos, count);
+        m_pending_pos += count;
+        copied += count;
+    }
+    return copied;
+}
+
+void JsonResultsExporter::write_to_fd(int fd)
+{
+    // Write the rendered JSON directly, without copying it into another buffer first.
+    while (m_pending_pos < m_pending.size() || render_more(chunk_size)) {
+        write_all(fd, m_pending.data() + m_pending_pos, m_pending.size() - m_pending_pos);
+        m_pending_pos = m_pending.size();
+    }
+}
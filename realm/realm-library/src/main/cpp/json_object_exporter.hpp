@@ -0,0 +1,101 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef REALM_JNI_IMPL_JSON_OBJECT_EXPORTER_HPP
+#define REALM_JNI_IMPL_JSON_OBJECT_EXPORTER_HPP
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <object_schema.hpp>
+#include <results.hpp>
+#include <schema.hpp>
+
+namespace realm {
+namespace _impl {
+
+// Renders objects as JSON, in the format read by import_json_objects(), so exported objects can be imported again.
+// Dates are written in ISO 8601 format with milliseconds and binaries as Base64 encoded strings. Floating point values
+// which cannot be represented in JSON (NaN and infinities) are written as null.
+class JsonObjectWriter {
+public:
+    // Only the given properties of the top level objects are written, or all of them if properties is empty. Links
+    // are written as nested objects up to link_depth levels, links further away are left out. Throws
+    // std::invalid_argument if a property cannot be found.
+    JsonObjectWriter(const Schema& schema, const ObjectSchema& object_schema,
+                     const std::vector<std::string>& properties, size_t link_depth);
+
+    // Appends the JSON object for the given row of the table of the class to out.
+    void write_object(std::string& out, const Table& table, size_t row_index)
+    {
+        write_object(out, m_top_level, table, row_index, 0);
+    }
+
+private:
+    struct ClassInfo {
+        const ObjectSchema* object_schema;
+        std::vector<const Property*> properties;
+    };
+
+    // A copy, so the writer stays valid if the schema of the Realm changes while exporting.
+    Schema m_schema;
+    size_t m_link_depth;
+    ClassInfo m_top_level;
+    std::unordered_map<const ObjectSchema*, ClassInfo> m_classes;
+
+    const ClassInfo& class_info(const std::string& object_type);
+    void write_object(std::string& out, const ClassInfo& info, const Table& table, size_t row_index, size_t depth);
+    void write_property(std::string& out, const Property& property, const Table& table, size_t row_index,
+                        size_t depth);
+    void write_list(std::string& out, const Property& property, const Table& table, size_t row_index, size_t depth);
+};
+
+// Exports the objects of a Results as a JSON array, incrementally. Objects are rendered only until the requested read
+// size, or a 64 KB chunk when writing to a file descriptor, is buffered, plus the rest of the last object. So the
+// memory usage doesn't depend on the number of objects. The objects are taken from a snapshot of the Results when the
+// exporter is created, objects deleted in the meantime are skipped. Must be used on the thread of the Realm.
+class JsonResultsExporter {
+public:
+    JsonResultsExporter(const Results& results, const std::vector<std::string>& properties, size_t link_depth);
+
+    // Copies the next bytes of the JSON into out, at most size. Returns the number of bytes copied, which is only 0
+    // once everything has been read.
+    size_t read(char* out, size_t size);
+
+    // Writes everything not read yet to a file descriptor, which is not closed.
+    void write_to_fd(int fd);
+
+private:
+    Results m_results;
+    JsonObjectWriter m_writer;
+    size_t m_next_row = 0;
+    bool m_started = false;
+    bool m_finished = false;
+    bool m_first_object = true;
+    std::string m_pending;
+    size_t m_pending_pos = 0;
+
+    // Renders more JSON into m_pending. Returns false if there is nothing left.
+    bool render_more(size_t min_size);
+};
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_JSON_OBJECT_EXPORTER_HPP
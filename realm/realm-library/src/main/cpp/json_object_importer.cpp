@@ -0,0 +1,813 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "json_object_importer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+#include <object.hpp>
+
+#include "java_object_accessor.hpp"
+#include "java_object_data.hpp"
+#include "util.hpp"
+
+#include "jni_util/java_class.hpp"
+#include "jni_util/java_exception_thrower.hpp"
+#include "jni_util/java_method.hpp"
+
+using namespace realm;
+using namespace realm::jni_util;
+using namespace realm::_impl;
+
+namespace {
+
+constexpr size_t chunk_size = 64 * 1024;
+// Deeper input is rejected instead of risking to run out of stack.
+constexpr size_t max_depth = 128;
+
+// Empty strings and binaries must not be confused with null ones.
+const char empty_data[] = "";
+
+// Pull parser for the JSON text of a JsonSource. Only tokenizes, the meaning of the values is decided by the caller.
+class JsonReader {
+public:
+    explicit JsonReader(JsonSource& source)
+        : m_source(source)
+    {
+    }
+
+    // Skips whitespace and returns the next character without consuming it, or 0 at the end of the input.
+    char peek()
+    {
+        while (m_pos != m_end || fill()) {
+            char c = *m_pos;
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                return c;
+            }
+            ++m_pos;
+        }
+        return 0;
+    }
+
+    bool consume(char c)
+    {
+        if (peek() != c) {
+            return false;
+        }
+        ++m_pos;
+        return true;
+    }
+
+    void expect(char c)
+    {
+        if (!consume(c)) {
+            throw error(std::string("'") + c + "' expected");
+        }
+    }
+
+    void expect_literal(const char* literal)
+    {
+        peek();
+        for (const char* p = literal; *p; ++p) {
+            if (next() != *p) {
+                throw error(std::string("'") + literal + "' expected");
+            }
+        }
+    }
+
+    // Reads a string into out, with the escape sequences resolved.
+    void read_string(std::string& out)
+    {
+        expect('"');
+        out.clear();
+        while (true) {
+            if (m_pos == m_end && !fill()) {
+                throw error("unterminated string");
+            }
+            // Copy the characters which don't need any processing in one go.
+            const char* start = m_pos;
+            while (m_pos != m_end && *m_pos != '"' && *m_pos != '\\' && static_cast<unsigned char>(*m_pos) >= 0x20) {
+                ++m_pos;
+            }
+            out.append(start, m_pos);
+            if (m_pos == m_end) {
+                continue;
+            }
+            char c = *m_pos++;
+            if (c == '"') {
+                return;
+            }
+            if (c != '\\') {
+                throw error("control character in string");
+            }
+            read_escape_sequence(out);
+        }
+    }
+
+    // Reads the text of a number into out. Returns false if it has a fraction or an exponent.
+    bool read_number(std::string& out)
+    {
+        peek();
+        out.clear();
+        bool integer = true;
+        while (m_pos != m_end || fill()) {
+            char c = *m_pos;
+            if (c == '.' || c == 'e' || c == 'E') {
+                integer = false;
+            }
+            else if ((c < '0' || c > '9') && c != '-' && c != '+') {
+                break;
+            }
+            out += c;
+            ++m_pos;
+        }
+        if (out.empty()) {
+            throw error("value expected");
+        }
+        return integer;
+    }
+
+    void skip_value(size_t depth)
+    {
+        if (depth > max_depth) {
+            throw error("too deeply nested");
+        }
+        switch (peek()) {
+            case '"':
+                read_string(m_skipped);
+                return;
+            case '{':
+                ++m_pos;
+                if (consume('}')) {
+                    return;
+                }
+                do {
+                    read_string(m_skipped);
+                    expect(':');
+                    skip_value(depth + 1);
+                } while (consume(','));
+                expect('}');
+                return;
+            case '[':
+                ++m_pos;
+                if (consume(']')) {
+                    return;
+                }
+                do {
+                    skip_value(depth + 1);
+                } while (consume(','));
+                expect(']');
+                return;
+            case 't':
+                expect_literal("true");
+                return;
+            case 'f':
+                expect_literal("false");
+                return;
+            case 'n':
+                expect_literal("null");
+                return;
+            default:
+                read_number(m_skipped);
+                return;
+        }
+    }
+
+    std::invalid_argument error(const std::string& message) const
+    {
+        return std::invalid_argument(
+            util::format("Invalid JSON at offset %1: %2.", m_chunk_offset + (m_pos - m_chunk), message));
+    }
+
+private:
+    JsonSource& m_source;
+    const char* m_chunk = nullptr;
+    const char* m_pos = nullptr;
+    const char* m_end = nullptr;
+    // Offset of the current chunk in the input, for error messages.
+    size_t m_chunk_offset = 0;
+    std::string m_skipped;
+
+    bool fill()
+    {
+        m_chunk_offset += m_end - m_chunk;
+        const char* data;
+        size_t size;
+        if (!m_source.next_chunk(data, size)) {
+            m_chunk = m_pos = m_end;
+            return false;
+        }
+        m_chunk = m_pos = data;
+        m_end = data + size;
+        return true;
+    }
+
+    char next()
+    {
+        if (m_pos == m_end && !fill()) {
+            throw error("unexpected end of input");
+        }
+        return *m_pos++;
+    }
+
+    unsigned read_hex4()
+    {
+        unsigned value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = next();
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= c - '0';
+            }
+            else if (c >= 'a' && c <= 'f') {
+                value |= c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F') {
+                value |= c - 'A' + 10;
+            }
+            else {
+                throw error("invalid \\u escape sequence");
+            }
+        }
+        return value;
+    }
+
+    void read_escape_sequence(std::string& out)
+    {
+        char c = next();
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                out += c;
+                return;
+            case 'b':
+                out += '\b';
+                return;
+            case 'f':
+                out += '\f';
+                return;
+            case 'n':
+                out += '\n';
+                return;
+            case 'r':
+                out += '\r';
+                return;
+            case 't':
+                out += '\t';
+                return;
+            case 'u':
+                break;
+            default:
+                throw error("invalid escape sequence");
+        }
+
+        uint32_t code_point = read_hex4();
+        if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+            throw error("unpaired surrogate");
+        }
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+            if (next() != '\\' || next() != 'u') {
+                throw error("unpaired surrogate");
+            }
+            uint32_t low = read_hex4();
+            if (low < 0xDC00 || low > 0xDFFF) {
+                throw error("unpaired surrogate");
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        }
+        else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+};
+
+// Days since 1970-01-01 of the given date in the proleptic Gregorian calendar.
+int64_t days_from_civil(int64_t year, unsigned month, unsigned day)
+{
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned year_of_era = static_cast<unsigned>(year - era * 400);
+    const unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<int64_t>(day_of_era) - 719468;
+}
+
+// Parses the date formats accepted by io.realm.internal.android.JsonUtils.stringToDate(). Returns false if the text
+// is not a date.
+bool parse_date(const std::string& text, int64_t& milliseconds)
+{
+    const char* p = text.c_str();
+    char* end;
+
+    // "/Date(<milliseconds>[+-zone])/", the zone is ignored.
+    static const char json_date_prefix[] = "/Date(";
+    if (text.compare(0, sizeof(json_date_prefix) - 1, json_date_prefix) == 0) {
+        p += sizeof(json_date_prefix) - 1;
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+        errno = 0;
+        milliseconds = std::strtoll(p, &end, 10);
+        return errno == 0 && std::strchr(end, ')') != nullptr;
+    }
+
+    // "<milliseconds>"
+    errno = 0;
+    milliseconds = std::strtoll(p, &end, 10);
+    if (end != p && *end == '\0') {
+        return errno == 0;
+    }
+
+    // ISO 8601: "yyyy-MM-dd['T'HH:mm[:ss[.SSS]][Z|+-hh[:mm]]]", UTC if there is no time zone.
+    auto read_digits = [&](size_t count, int& value) {
+        value = 0;
+        for (size_t i = 0; i < count; ++i, ++p) {
+            if (*p < '0' || *p > '9') {
+                return false;
+            }
+            value = value * 10 + (*p - '0');
+        }
+        return true;
+    };
+    int year, month, day, hour = 0, minute = 0, second = 0, millisecond = 0;
+    if (!read_digits(4, year) || *p++ != '-' || !read_digits(2, month) || *p++ != '-' || !read_digits(2, day) ||
+        month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    int64_t offset_minutes = 0;
+    if (*p == 'T') {
+        ++p;
+        if (!read_digits(2, hour) || *p++ != ':' || !read_digits(2, minute)) {
+            return false;
+        }
+        if (*p == ':') {
+            ++p;
+            if (!read_digits(2, second)) {
+                return false;
+            }
+            if (*p == '.') {
+                ++p;
+                // Only milliseconds are kept, further digits are ignored.
+                int scale = 100;
+                if (*p < '0' || *p > '9') {
+                    return false;
+                }
+                for (; *p >= '0' && *p <= '9'; ++p) {
+                    millisecond += (*p - '0') * scale;
+                    scale /= 10;
+                }
+            }
+        }
+        if (*p == 'Z') {
+            ++p;
+        }
+        else if (*p == '+' || *p == '-') {
+            int sign = *p++ == '-' ? -1 : 1;
+            int offset_hours, offset_mins = 0;
+            if (!read_digits(2, offset_hours)) {
+                return false;
+            }
+            if (*p == ':') {
+                ++p;
+            }
+            if (*p != '\0' && !read_digits(2, offset_mins)) {
+                return false;
+            }
+            offset_minutes = sign * (offset_hours * 60 + offset_mins);
+        }
+    }
+    if (*p != '\0' || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+    int64_t seconds = days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400 +
+                      hour * 3600 + minute * 60 + second - offset_minutes * 60;
+    milliseconds = seconds * 1000 + millisecond;
+    return true;
+}
+
+int base64_value(char c)
+{
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9') {
+        return c - '0' + 52;
+    }
+    if (c == '+' || c == '-') {
+        return 62;
+    }
+    if (c == '/' || c == '_') {
+        return 63;
+    }
+    return -1;
+}
+
+// Decodes Base64 (standard or URL safe alphabet, padding and line breaks are ignored) into the arena. Returns false if
+// the text is not valid Base64.
+bool decode_base64(const std::string& text, JavaValueArena& arena, BinaryData& result)
+{
+    if (text.empty()) {
+        result = BinaryData(empty_data, 0);
+        return true;
+    }
+    char* out = arena.allocate(text.size() / 4 * 3 + 3);
+    size_t size = 0;
+    uint32_t bits = 0;
+    int bit_count = 0;
+    for (char c : text) {
+        if (c == '=' || c == '\n' || c == '\r' || c == ' ') {
+            continue;
+        }
+        int value = base64_value(c);
+        if (value < 0) {
+            return false;
+        }
+        bits = (bits << 6) | static_cast<uint32_t>(value);
+        bit_count += 6;
+        if (bit_count >= 8) {
+            bit_count -= 8;
+            out[size++] = static_cast<char>((bits >> bit_count) & 0xFF);
+        }
+    }
+    arena.shrink_last(out, size);
+    result = BinaryData(size ? out : empty_data, size);
+    return true;
+}
+
+// Decodes the elements of a JSON array into objects of a class and writes them with Object::create().
+class JsonObjectImporter {
+public:
+    JsonObjectImporter(JNIEnv* env, SharedRealm realm, JsonSource& source)
+        : m_env(env)
+        , m_realm(std::move(realm))
+        , m_reader(source)
+    {
+    }
+
+    size_t import(const ObjectSchema& object_schema, bool update_existing)
+    {
+        const ClassInfo& info = class_info(object_schema);
+        JavaContext ctx(m_env, m_realm, object_schema);
+        // Reused for all objects, so the memory usage is bound by the largest object.
+        JavaObjectData data(info.column_count);
+        JavaValue values = data.as_value();
+
+        size_t count = 0;
+        m_reader.expect('[');
+        if (!m_reader.consume(']')) {
+            do {
+                data.reset(JavaValue::missing());
+                read_object(info, data.values().data(), data.arena(), 0);
+                Object::create(ctx, m_realm, object_schema, values, update_existing, false);
+                ++count;
+            } while (m_reader.consume(','));
+            m_reader.expect(']');
+        }
+        if (m_reader.peek() != 0) {
+            throw m_reader.error("unexpected data after the array");
+        }
+        return count;
+    }
+
+private:
+    // The properties of a class by their name in JSON, resolved once per import.
+    struct ClassInfo {
+        const ObjectSchema* object_schema;
+        // The values of an object are indexed by column, see JavaContext::value_for_property().
+        size_t column_count = 0;
+        std::unordered_map<std::string, const Property*> properties;
+        // The classes of the link properties, resolved when they are first used.
+        mutable std::unordered_map<const Property*, const ClassInfo*> link_targets;
+    };
+
+    JNIEnv* m_env;
+    SharedRealm m_realm;
+    JsonReader m_reader;
+    std::unordered_map<const ObjectSchema*, ClassInfo> m_classes;
+    // Scratch buffers reused for all values.
+    std::string m_key;
+    std::string m_text;
+    // The items of the lists being read, one vector per nesting level. A deque doesn't move the vectors when growing.
+    std::deque<std::vector<JavaValue>> m_list_items;
+
+    const ClassInfo& class_info(const ObjectSchema& object_schema)
+    {
+        auto it = m_classes.find(&object_schema);
+        if (it != m_classes.end()) {
+            return it->second;
+        }
+        ClassInfo& info = m_classes[&object_schema];
+        info.object_schema = &object_schema;
+        for (const Property& property : object_schema.persisted_properties) {
+            info.column_count = std::max(info.column_count, property.table_column + 1);
+            info.properties[property.name] = &property;
+        }
+        return info;
+    }
+
+    const ClassInfo& link_target(const ClassInfo& info, const Property& property)
+    {
+        auto it = info.link_targets.find(&property);
+        if (it != info.link_targets.end()) {
+            return *it->second;
+        }
+        auto object_schema = m_realm->schema().find(property.object_type);
+        if (object_schema == m_realm->schema().end()) {
+            throw std::invalid_argument(
+                util::format("Class '%1' cannot be found in the schema.", property.object_type));
+        }
+        const ClassInfo& target = class_info(*object_schema);
+        info.link_targets[&property] = &target;
+        return target;
+    }
+
+    void read_object(const ClassInfo& info, JavaValue* values, JavaValueArena& arena, size_t depth)
+    {
+        if (depth > max_depth) {
+            throw m_reader.error("too deeply nested");
+        }
+        m_reader.expect('{');
+        if (m_reader.consume('}')) {
+            return;
+        }
+        do {
+            m_reader.read_string(m_key);
+            m_reader.expect(':');
+            auto it = info.properties.find(m_key);
+            if (it == info.properties.end()) {
+                m_reader.skip_value(depth + 1);
+                continue;
+            }
+            const Property& property = *it->second;
+            values[property.table_column] = read_property_value(info, property, arena, depth);
+        } while (m_reader.consume(','));
+        m_reader.expect('}');
+    }
+
+    JavaValue read_property_value(const ClassInfo& info, const Property& property, JavaValueArena& arena,
+                                  size_t depth)
+    {
+        if (m_reader.peek() == 'n') {
+            m_reader.expect_literal("null");
+            return JavaValue();
+        }
+        if (!is_array(property.type)) {
+            return read_value(info, property, arena, depth);
+        }
+
+        m_reader.expect('[');
+        if (m_reader.consume(']')) {
+            return JavaValue(JavaValueList());
+        }
+        if (m_list_items.size() <= depth) {
+            m_list_items.resize(depth + 1);
+        }
+        std::vector<JavaValue>& items = m_list_items[depth];
+        items.clear();
+        do {
+            if (m_reader.peek() == 'n') {
+                m_reader.expect_literal("null");
+                items.emplace_back();
+            }
+            else {
+                items.push_back(read_value(info, property, arena, depth));
+            }
+        } while (m_reader.consume(','));
+        m_reader.expect(']');
+
+        JavaValue* list = arena.allocate_array<JavaValue>(items.size());
+        std::uninitialized_copy(items.begin(), items.end(), list);
+        return JavaValue(JavaValueList(list, items.size()));
+    }
+
+    // Reads a non-null value of the property, or a list item if the property is a list.
+    JavaValue read_value(const ClassInfo& info, const Property& property, JavaValueArena& arena, size_t depth)
+    {
+        switch (property.type & ~PropertyType::Flags) {
+            case PropertyType::Int: {
+                if (!m_reader.read_number(m_text)) {
+                    throw value_error(info, property, "an integer");
+                }
+                errno = 0;
+                char* end;
+                long long value = std::strtoll(m_text.c_str(), &end, 10);
+                if (errno != 0 || *end != '\0') {
+                    throw value_error(info, property, "an integer");
+                }
+                return JavaValue(static_cast<jlong>(value));
+            }
+            case PropertyType::Bool:
+                if (m_reader.peek() == 't') {
+                    m_reader.expect_literal("true");
+                    return JavaValue(static_cast<jboolean>(JNI_TRUE));
+                }
+                m_reader.expect_literal("false");
+                return JavaValue(static_cast<jboolean>(JNI_FALSE));
+            case PropertyType::Float:
+                return JavaValue(static_cast<jfloat>(read_double(info, property)));
+            case PropertyType::Double:
+                return JavaValue(static_cast<jdouble>(read_double(info, property)));
+            case PropertyType::String: {
+                if (m_reader.peek() != '"') {
+                    throw value_error(info, property, "a string");
+                }
+                m_reader.read_string(m_text);
+                if (m_text.empty()) {
+                    return JavaValue(StringData(empty_data, 0));
+                }
+                char* data = arena.allocate(m_text.size());
+                std::copy(m_text.begin(), m_text.end(), data);
+                return JavaValue(StringData(data, m_text.size()));
+            }
+            case PropertyType::Data: {
+                BinaryData binary;
+                if (m_reader.peek() != '"') {
+                    throw value_error(info, property, "a Base64 string");
+                }
+                m_reader.read_string(m_text);
+                if (!decode_base64(m_text, arena, binary)) {
+                    throw value_error(info, property, "a Base64 string");
+                }
+                return JavaValue(binary);
+            }
+            case PropertyType::Date: {
+                int64_t milliseconds;
+                if (m_reader.peek() == '"') {
+                    m_reader.read_string(m_text);
+                    if (!parse_date(m_text, milliseconds)) {
+                        throw value_error(info, property, "a date");
+                    }
+                }
+                else {
+                    errno = 0;
+                    char* end;
+                    bool integer = m_reader.read_number(m_text);
+                    milliseconds = std::strtoll(m_text.c_str(), &end, 10);
+                    if (!integer || errno != 0 || *end != '\0') {
+                        throw value_error(info, property, "a date");
+                    }
+                }
+                return JavaValue(from_milliseconds(milliseconds));
+            }
+            case PropertyType::Object: {
+                if (m_reader.peek() != '{') {
+                    throw value_error(info, property, "an object");
+                }
+                // The linked object is created from its values by JavaContext::unbox<RowExpr>().
+                const ClassInfo& target = link_target(info, property);
+                JavaValue* values = arena.allocate_array<JavaValue>(target.column_count);
+                std::uninitialized_fill_n(values, target.column_count, JavaValue::missing());
+                read_object(target, values, arena, depth + 1);
+                return JavaValue(JavaValueList(values, target.column_count));
+            }
+            default:
+                throw std::invalid_argument(util::format("Property '%1.%2' of type '%3' cannot be imported from JSON.",
+                                                         info.object_schema->name, property.name,
+                                                         string_for_property_type(property.type)));
+        }
+    }
+
+    double read_double(const ClassInfo& info, const Property& property)
+    {
+        m_reader.read_number(m_text);
+        char* end;
+        double value = std::strtod(m_text.c_str(), &end);
+        if (*end != '\0') {
+            throw value_error(info, property, "a number");
+        }
+        return value;
+    }
+
+    std::invalid_argument value_error(const ClassInfo& info, const Property& property, const char* expected) const
+    {
+        return m_reader.error(util::format("%1 is expected for property '%2.%3'", expected, info.object_schema->name,
+                                           property.name));
+    }
+};
+
+} // anonymous namespace
+
+JsonFdSource::JsonFdSource(int fd)
+    : m_fd(fd)
+    , m_buffer(new char[chunk_size])
+{
+}
+
+bool JsonFdSource::next_chunk(const char*& data, size_t& size)
+{
+    ssize_t read_size;
+    do {
+        read_size = ::read(m_fd, m_buffer.get(), chunk_size);
+    } while (read_size < 0 && errno == EINTR);
+    if (read_size < 0) {
+        throw std::system_error(errno, std::system_category(), "Could not read the JSON input");
+    }
+    data = m_buffer.get();
+    size = static_cast<size_t>(read_size);
+    return read_size > 0;
+}
+
+JsonMemorySource::JsonMemorySource(const char* data, size_t size)
+    : m_data(data)
+    , m_size(size)
+{
+}
+
+bool JsonMemorySource::next_chunk(const char*& data, size_t& size)
+{
+    // Everything is handed out as a single chunk.
+    if (m_size == 0) {
+        return false;
+    }
+    data = m_data;
+    size = m_size;
+    m_size = 0;
+    return true;
+}
+
+JsonInputStreamSource::JsonInputStreamSource(JNIEnv* env, jobject input_stream)
+    : m_env(env)
+    , m_input_stream(input_stream)
+    , m_java_buffer(env->NewByteArray(static_cast<jsize>(chunk_size)))
+    , m_buffer(new char[chunk_size])
+{
+    if (!m_java_buffer) {
+        throw std::bad_alloc();
+    }
+}
+
+JsonInputStreamSource::~JsonInputStreamSource()
+{
+    m_env->DeleteLocalRef(m_java_buffer);
+}
+
+bool JsonInputStreamSource::next_chunk(const char*& data, size_t& size)
+{
+    static JavaClass input_stream_class(m_env, "java/io/InputStream");
+    static JavaMethod read_method(m_env, input_stream_class, "read", "([BII)I");
+
+    jint read_size;
+    do {
+        read_size = m_env->CallIntMethod(m_input_stream, read_method, m_java_buffer, 0, static_cast<jint>(chunk_size));
+        TERMINATE_JNI_IF_JAVA_EXCEPTION_OCCURRED(m_env, nullptr);
+    } while (read_size == 0);
+    if (read_size < 0) {
+        return false;
+    }
+    m_env->GetByteArrayRegion(m_java_buffer, 0, read_size, reinterpret_cast<jbyte*>(m_buffer.get()));
+    data = m_buffer.get();
+    size = static_cast<size_t>(read_size);
+    return true;
+}
+
+size_t realm::_impl::import_json_objects(JNIEnv* env, SharedRealm realm, const ObjectSchema& object_schema,
+                                         JsonSource& source, bool update_existing)
+{
+    JsonObjectImporter importer(env, std::move(realm), source);
+    return importer.import(object_schema, update_existing);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef REALM_JNI_IMPL_JSON_OBJECT_IMPORTER_HPP
+#define REALM_JNI_IMPL_JSON_OBJECT_IMPORTER_HPP
+
+#include <jni.h>
+
+#include <cstddef>
+#include <memory>
+
+#include <object_schema.hpp>
+#include <shared_realm.hpp>
+
+namespace realm {
+namespace _impl {
+
+// Where the JSON text is read from. The text is consumed as a sequence of chunks, so the whole input never has to be
+// in memory at once.
+class JsonSource {
+public:
+    virtual ~JsonSource() = default;
+
+    // Points data to the next non-empty chunk and returns true, or returns false at the end of the input. The chunk
+    // stays valid until the next call.
+    virtual bool next_chunk(const char*& data, size_t& size) = 0;
+};
+
+// Reads from a file descriptor, which is not closed afterwards.
+class JsonFdSource : public JsonSource {
+public:
+    explicit JsonFdSource(int fd);
+    bool next_chunk(const char*& data, size_t& size) override;
+
+private:
+    int m_fd;
+    std::unique_ptr<char[]> m_buffer;
+};
+
+// Reads from memory owned by the caller, without copying it.
+class JsonMemorySource : public JsonSource {
+public:
+    JsonMemorySource(const char* data, size_t size);
+    bool next_chunk(const char*& data, size_t& size) override;
+
+private:
+    const char* m_data;
+    size_t m_size;
+};
+
+// Reads from a java.io.InputStream, one byte[] chunk at a time.
+class JsonInputStreamSource : public JsonSource {
+public:
+    JsonInputStreamSource(JNIEnv* env, jobject input_stream);
+    ~JsonInputStreamSource();
+    bool next_chunk(const char*& data, size_t& size) override;
+
+private:
+    JNIEnv* m_env;
+    jobject m_input_stream;
+    jbyteArray m_java_buffer;
+    std::unique_ptr<char[]> m_buffer;
+};
+
+// Creates an object of the given class for each element of a JSON array of objects, and returns how many were
+// created or updated. The objects are written while the text is parsed, so memory usage doesn't depend on the size of
+// the input. Must be called inside a write transaction.
+//
+// JSON properties are matched by the name of the properties in the schema, unknown ones are skipped. Fields renamed
+// with @RealmField or a naming policy must be given with their name in the Realm file. Properties not given keep their
+// current value when updating an object and get the default value of their column when creating one. Nested JSON
+// objects are created (or updated) as linked objects. Dates can be given as milliseconds since the epoch, as
+// "/Date(<milliseconds>)/" or in ISO 8601 format, binaries are Base64 encoded strings.
+//
+// Throws std::invalid_argument if the JSON is malformed or a value doesn't match the type of its property.
+size_t import_json_objects(JNIEnv* env, SharedRealm realm, const ObjectSchema& object_schema, JsonSource& source,
+                           bool update_existing);
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_JSON_OBJECT_IMPORTER_HPP
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_NATIVE_OBJECT_STATS_HPP
+#define REALM_JNI_IMPL_NATIVE_OBJECT_STATS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <realm/row.hpp>
+#include <realm/table_view.hpp>
+
+#include <collection_notifications.hpp>
+
+namespace realm {
+namespace _impl {
+
+// Live count and byte counters for the native objects which are handed over to Java as a pointer and freed by the
+// finalizer daemon thread. The counters are updated where the objects are created (nativeCreateXxx or any other JNI
+// call returning a new pointer) and in the corresponding finalize_xxx function. The byte count is an estimation of
+// the memory held by the object itself, memory owned by Core (e.g.: the Table accessors) is not included.
+//
+// Creation and finalization happen on different threads, so all counters are atomics. Relaxed ordering is enough
+// since the values are only used for monitoring.
+//
+// The values of Type must be kept in sync with the TYPE_XXX constants in io.realm.internal.NativeObjectStats.
+class NativeObjectStats {
+public:
+    enum class Type {
+        Row = 0,
+        TableView,
+        Results,
+        List,
+        Object,
+        CollectionChangeSet,
+        ObjectBuilder,
+        DescriptorOrdering,
+        NumTypes // Always keep this as the last one!
+    };
+
+    static constexpr size_t num_types = static_cast<size_t>(Type::NumTypes);
+
+    static inline void on_create(Type type, size_t bytes) noexcept
+    {
+        auto& counter = counters()[static_cast<size_t>(type)];
+        counter.live_count.fetch_add(1, std::memory_order_relaxed);
+        counter.live_bytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    static inline void on_destroy(Type type, size_t bytes) noexcept
+    {
+        auto& counter = counters()[static_cast<size_t>(type)];
+        counter.live_count.fetch_sub(1, std::memory_order_relaxed);
+        counter.live_bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    static inline int64_t live_count(Type type) noexcept
+    {
+        return counters()[static_cast<size_t>(type)].live_count.load(std::memory_order_relaxed);
+    }
+
+    static inline int64_t live_bytes(Type type) noexcept
+    {
+        return counters()[static_cast<size_t>(type)].live_bytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Counter {
+        std::atomic<int64_t> live_count{0};
+        std::atomic<int64_t> live_bytes{0};
+    };
+
+    static Counter* counters() noexcept;
+};
+
+// Allocates a Row which will be owned by a Java UncheckedRow/CheckedRow and freed by finalize_unchecked_row.
+template <typename T>
+inline Row* new_tracked_row(T&& row)
+{
+    Row* row_ptr = new Row(std::forward<T>(row));
+    NativeObjectStats::on_create(NativeObjectStats::Type::Row, sizeof(Row));
+    return row_ptr;
+}
+
+// Rough estimation of the memory held by a CollectionChangeSet. The change set is immutable once it has been handed
+// over to Java, so the same value is computed when it is created and when it is finalized.
+inline size_t estimated_size(const CollectionChangeSet& change_set) noexcept
+{
+    auto ranges_size = [](const IndexSet& index_set) {
+        size_t count = 0;
+        for (auto& range : index_set) {
+            static_cast<void>(range);
+            ++count;
+        }
+        return count * sizeof(std::pair<size_t, size_t>);
+    };
+    return sizeof(CollectionChangeSet) + ranges_size(change_set.deletions) + ranges_size(change_set.insertions) +
+           ranges_size(change_set.modifications) + ranges_size(change_set.modifications_new) +
+           change_set.moves.size() * sizeof(CollectionChangeSet::Move);
+}
+
+// Copies a CollectionChangeSet which will be owned by a Java OsCollectionChangeSet and freed by finalize_changeset.
+inline CollectionChangeSet* new_tracked_change_set(const CollectionChangeSet& change_set)
+{
+    auto change_set_ptr = new CollectionChangeSet(change_set);
+    NativeObjectStats::on_create(NativeObjectStats::Type::CollectionChangeSet, estimated_size(*change_set_ptr));
+    return change_set_ptr;
+}
+
+// TableView which is owned by a Java object, either directly or through a Query created from it. The Query holds it
+// as a std::unique_ptr<TableViewBase>, so the destructor is the only place where we know it is going away.
+class TrackedTableView : public TableView {
+public:
+    explicit TrackedTableView(TableView&& table_view)
+        : TableView(std::move(table_view))
+        , m_tracked_bytes(sizeof(TrackedTableView) + size() * sizeof(int64_t))
+    {
+        NativeObjectStats::on_create(NativeObjectStats::Type::TableView, m_tracked_bytes);
+    }
+
+    ~TrackedTableView() noexcept override
+    {
+        NativeObjectStats::on_destroy(NativeObjectStats::Type::TableView, m_tracked_bytes);
+    }
+
+    TrackedTableView(const TrackedTableView&) = delete;
+    TrackedTableView& operator=(const TrackedTableView&) = delete;
+
+private:
+    // The size of the view might change when it is synced, remember what has been added to the counter.
+    const size_t m_tracked_bytes;
+};
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_NATIVE_OBJECT_STATS_HPP
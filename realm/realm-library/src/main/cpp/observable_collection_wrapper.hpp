@@ -21,6 +21,12 @@
 #include "jni_util/java_global_weak_ref.hpp"
 #include "jni_util/java_method.hpp"
 #include "jni_util/log.hpp"
+#include "native_object_stats.hpp"
+#include "results_position_index.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 #include <results.hpp>
 #include <realm/util/optional.hpp>
@@ -28,6 +34,264 @@
 namespace realm {
 namespace _impl {
 
+// Mixes the value of a column of a row into a key path digest (64-bit FNV-1a). Returns false for links, lists and
+// mixed columns, whose changes can't be told from the value stored in the row.
+inline bool hash_column_value(uint64_t& hash, const Table& table, size_t col, size_t row)
+{
+    auto mix = [&hash](const void* data, size_t size) {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    DataType type = table.get_column_type(col);
+    switch (type) {
+        case type_Int:
+        case type_Bool:
+        case type_Float:
+        case type_Double:
+        case type_String:
+        case type_Binary:
+        case type_OldDateTime:
+        case type_Timestamp:
+            break;
+        default:
+            return false;
+    }
+    unsigned char is_null = table.is_nullable(col) && table.is_null(col, row) ? 1 : 0;
+    mix(&is_null, sizeof(is_null));
+    if (is_null) {
+        return true;
+    }
+    switch (type) {
+        case type_Int: {
+            int64_t value = table.get_int(col, row);
+            mix(&value, sizeof(value));
+            break;
+        }
+        case type_Bool: {
+            bool value = table.get_bool(col, row);
+            mix(&value, sizeof(value));
+            break;
+        }
+        case type_Float: {
+            float value = table.get_float(col, row);
+            mix(&value, sizeof(value));
+            break;
+        }
+        case type_Double: {
+            double value = table.get_double(col, row);
+            mix(&value, sizeof(value));
+            break;
+        }
+        case type_String: {
+            StringData value = table.get_string(col, row);
+            size_t size = value.size();
+            mix(&size, sizeof(size));
+            mix(value.data(), size);
+            break;
+        }
+        case type_Binary: {
+            BinaryData value = table.get_binary(col, row);
+            size_t size = value.size();
+            mix(&size, sizeof(size));
+            mix(value.data(), size);
+            break;
+        }
+        case type_OldDateTime: {
+            int_fast64_t value = table.get_olddatetime(col, row).get_olddatetime();
+            mix(&value, sizeof(value));
+            break;
+        }
+        case type_Timestamp: {
+            Timestamp value = table.get_timestamp(col, row);
+            int64_t seconds = value.get_seconds();
+            int32_t nanoseconds = value.get_nanoseconds();
+            mix(&seconds, sizeof(seconds));
+            mix(&nanoseconds, sizeof(nanoseconds));
+            break;
+        }
+        default:
+            REALM_UNREACHABLE();
+    }
+    return true;
+}
+
+// A digest of the values of the filtered columns of each object in a collection, by position. Results and List
+// notifiers don't record which columns modified a row, so the key path filter compares the digest of a modified
+// object with the one from the previous notification. The whole collection is only read when the snapshot is taken,
+// a change set shifts the digests and reads the inserted and modified objects only.
+class KeyPathSnapshot {
+public:
+    bool is_taken() const
+    {
+        return m_taken;
+    }
+
+    // Forgets the digests, e.g. after the filter has changed.
+    void clear()
+    {
+        m_digests = {};
+        m_taken = false;
+        m_comparable = true;
+    }
+
+    template <typename T>
+    void reset(T& collection, const std::vector<size_t>& columns)
+    {
+        clear();
+        m_taken = true;
+        size_t size = collection.size();
+        m_digests.reserve(size);
+        for (size_t i = 0; i < size && m_comparable; ++i) {
+            m_digests.push_back(read(collection, columns, i));
+        }
+        if (!m_comparable) {
+            m_digests = {};
+        }
+    }
+
+    // Applies a change set to the digests and returns the modified positions in the new collection whose filtered
+    // values changed. Every modification is returned if a filtered column can't be compared by value.
+    template <typename T>
+    IndexSet apply(T& collection, const std::vector<size_t>& columns, const CollectionChangeSet& changes)
+    {
+        if (!m_comparable) {
+            return changes.modifications_new;
+        }
+        size_t new_size = collection.size();
+        size_t deleted = changes.deletions.count();
+        if (deleted > m_digests.size() || m_digests.size() - deleted + changes.insertions.count() != new_size) {
+            // Out of sync with the change set, start over.
+            reset(collection, columns);
+            return changes.modifications_new;
+        }
+
+        std::vector<uint64_t> digests;
+        if (!changes.deletions.empty() || !changes.insertions.empty()) {
+            std::unordered_map<size_t, size_t> moved_from;
+            for (auto& move : changes.moves) {
+                moved_from[move.to] = move.from;
+            }
+            digests.reserve(new_size);
+            auto deletions = changes.deletions.as_indexes();
+            auto insertions = changes.insertions.as_indexes();
+            auto next_deletion = deletions.begin();
+            auto next_insertion = insertions.begin();
+            size_t old_ndx = 0;
+            for (size_t i = 0; i < new_size; ++i) {
+                if (next_insertion != insertions.end() && *next_insertion == i) {
+                    ++next_insertion;
+                    auto move = moved_from.find(i);
+                    digests.push_back(move != moved_from.end() ? m_digests[move->second]
+                                                               : read(collection, columns, i));
+                    continue;
+                }
+                while (next_deletion != deletions.end() && *next_deletion == old_ndx) {
+                    ++next_deletion;
+                    ++old_ndx;
+                }
+                digests.push_back(m_digests[old_ndx++]);
+            }
+            m_digests = std::move(digests);
+        }
+
+        IndexSet changed;
+        for (auto i : changes.modifications_new.as_indexes()) {
+            uint64_t digest = read(collection, columns, i);
+            if (i >= m_digests.size() || m_digests[i] != digest) {
+                changed.add(i);
+            }
+            if (i < m_digests.size()) {
+                m_digests[i] = digest;
+            }
+        }
+        if (!m_comparable) {
+            m_digests = {};
+            return changes.modifications_new;
+        }
+        return changed;
+    }
+
+private:
+    std::vector<uint64_t> m_digests;
+    bool m_taken = false;
+    bool m_comparable = true;
+
+    template <typename T>
+    uint64_t read(T& collection, const std::vector<size_t>& columns, size_t position)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        auto row = collection.get(position);
+        if (!row.is_attached()) {
+            return hash;
+        }
+        const Table& table = *row.get_table();
+        for (auto col : columns) {
+            if (!hash_column_value(hash, table, col, row.get_index())) {
+                m_comparable = false;
+                break;
+            }
+        }
+        return hash;
+    }
+};
+
+// Returns the index in the old collection of an object which is at new_index after the change set.
+inline size_t old_index_of(const CollectionChangeSet& changes, size_t new_index)
+{
+    for (auto& move : changes.moves) {
+        if (move.to == new_index) {
+            return move.from;
+        }
+    }
+    return changes.deletions.shift(changes.insertions.unshift(new_index));
+}
+
+// Applies the key path filter of a collection listener to a change set. Modifications of objects whose filtered
+// values didn't change are removed, modifications Object Store attributes to a filtered column in
+// CollectionChangeSet::columns are always kept. Returns none if nothing is left, so the listeners don't need to be
+// called.
+template <typename T>
+util::Optional<CollectionChangeSet> filter_change_set(const CollectionChangeSet& changes,
+                                                      const std::vector<size_t>& columns, T& collection,
+                                                      KeyPathSnapshot& snapshot)
+{
+    if (!snapshot.is_taken()) {
+        snapshot.reset(collection, columns);
+        return changes;
+    }
+    if (changes.empty()) {
+        return changes;
+    }
+
+    IndexSet kept = snapshot.apply(collection, columns, changes);
+    for (size_t col = 0; col < changes.columns.size(); ++col) {
+        if (std::find(columns.begin(), columns.end(), col) == columns.end()) {
+            continue;
+        }
+        for (auto i : changes.columns[col].as_indexes()) {
+            if (changes.modifications_new.contains(i)) {
+                kept.add(i);
+            }
+        }
+    }
+    if (kept.count() == changes.modifications_new.count()) {
+        return changes;
+    }
+
+    CollectionChangeSet filtered = changes;
+    filtered.modifications_new = kept;
+    filtered.modifications = IndexSet();
+    for (auto i : kept.as_indexes()) {
+        filtered.modifications.add(old_index_of(changes, i));
+    }
+    if (filtered.empty()) {
+        return util::none;
+    }
+    return filtered;
+}
+
 // Wrapper of Object Store List & Results.
 // We need to control the life cycle of Results/List, weak ref of Java OsResults/OsList object and the NotificationToken.
 // Wrap all three together, so when the Java OsResults/OsList object gets GCed, all three of them will be invalidated.
@@ -55,10 +319,27 @@ public:
     void start_listening(JNIEnv* env, jobject j_collection_object);
     void stop_listening();
 
+    // Only changes to these columns of the objects in the collection trigger the listeners, see filter_change_set().
+    // An empty filter means all columns.
+    void set_key_path_filter(std::vector<size_t> columns)
+    {
+        m_key_path_columns = std::move(columns);
+        m_key_path_snapshot.clear();
+    }
+
+    // Only used for Results.
+    ResultsPositionIndex& position_index()
+    {
+        return m_position_index;
+    }
+
 private:
     jni_util::JavaGlobalWeakRef m_collection_weak_ref;
     NotificationToken m_notification_token;
     T m_collection;
+    std::vector<size_t> m_key_path_columns;
+    KeyPathSnapshot m_key_path_snapshot;
+    ResultsPositionIndex m_position_index;
 };
 
 template <typename T>
@@ -86,10 +367,19 @@ void ObservableCollectionWrapper<T>::start_listening(JNIEnv* env, jobject j_coll
             }
         }
 
+        util::Optional<CollectionChangeSet> filtered;
+        if (!m_key_path_columns.empty()) {
+            filtered = filter_change_set(changes, m_key_path_columns, m_collection, m_key_path_snapshot);
+            if (!filtered) {
+                return;
+            }
+        }
+        const CollectionChangeSet& delivered = filtered ? *filtered : changes;
+
         m_collection_weak_ref.call_with_local_ref(env, [&](JNIEnv* local_env, jobject collection_obj) {
             local_env->CallVoidMethod(
                 collection_obj, notify_change_listeners,
-                reinterpret_cast<jlong>(changes.empty() ? 0 : new CollectionChangeSet(changes)));
+                reinterpret_cast<jlong>(delivered.empty() ? 0 : new_tracked_change_set(delivered)));
         });
     };
 
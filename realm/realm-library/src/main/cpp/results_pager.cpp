@@ -0,0 +1,221 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "results_pager.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <realm/table.hpp>
+#include <realm/table_view.hpp>
+#include <realm/util/assert.hpp>
+
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+namespace {
+
+template <typename T>
+inline int three_way_compare(const T& a, const T& b) noexcept
+{
+    return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+} // anonymous namespace
+
+ResultsPager::ResultsPager(Query query, std::vector<SortColumn> sort_columns, size_t offset, size_t page_size)
+    : m_query(std::move(query))
+    , m_sort_columns(std::move(sort_columns))
+    , m_offset(offset)
+    , m_page_size(page_size)
+{
+    if (page_size == 0) {
+        throw std::invalid_argument("The page size must be greater than 0.");
+    }
+
+    const Table& table = *m_query.get_table();
+    m_column_types.reserve(m_sort_columns.size());
+    for (auto& sort_column : m_sort_columns) {
+        if (sort_column.column >= table.get_column_count()) {
+            throw std::invalid_argument(util::format("Invalid column index: %1.", sort_column.column));
+        }
+        DataType type = table.get_column_type(sort_column.column);
+        switch (type) {
+            case type_Int:
+            case type_Bool:
+            case type_Float:
+            case type_Double:
+            case type_String:
+            case type_Timestamp:
+                break;
+            default:
+                throw std::invalid_argument(util::format("Pages cannot be sorted by field '%1'.",
+                                                         table.get_column_name(sort_column.column)));
+        }
+        m_column_types.push_back(type);
+    }
+}
+
+std::vector<size_t> ResultsPager::next_page()
+{
+    if (!m_has_snapshot) {
+        take_snapshot();
+        m_has_snapshot = true;
+    }
+    if (!m_matches.is_attached()) {
+        // The table has been removed.
+        return {};
+    }
+    return m_sort_columns.empty() ? next_unsorted_page() : next_sorted_page();
+}
+
+void ResultsPager::take_snapshot()
+{
+    m_matches = m_query.find_all();
+    if (m_sort_columns.empty()) {
+        m_next_position = m_offset;
+    }
+}
+
+std::vector<size_t> ResultsPager::next_unsorted_page()
+{
+    std::vector<size_t> page;
+    while (page.size() < m_page_size && m_next_position < m_matches.size()) {
+        size_t position = m_next_position++;
+        if (m_matches.is_row_attached(position)) {
+            page.push_back(m_matches.get_source_ndx(position));
+        }
+    }
+    return page;
+}
+
+std::vector<size_t> ResultsPager::next_sorted_page()
+{
+    // The offset is only skipped by the first page, which selects it together with its own rows.
+    size_t skipped = m_has_cursor ? 0 : m_offset;
+    size_t limit = skipped + m_page_size;
+
+    // A max-heap in the sort order, the front is the last of the rows selected so far.
+    auto comes_before = [this](const Entry& a, const Entry& b) { return compare(a, b) < 0; };
+    std::vector<Entry> selected;
+    selected.reserve(std::min(limit, m_matches.size()));
+    const Table& table = *m_query.get_table();
+    Entry candidate;
+    for (size_t position = 0; position < m_matches.size(); ++position) {
+        if (!m_matches.is_row_attached(position)) {
+            continue;
+        }
+        candidate.position = position;
+        read_key(table, m_matches.get_source_ndx(position), candidate.key);
+        if (m_has_cursor && compare(candidate, m_cursor) <= 0) {
+            continue;
+        }
+        if (selected.size() < limit) {
+            selected.push_back(candidate);
+            std::push_heap(selected.begin(), selected.end(), comes_before);
+        }
+        else if (compare(candidate, selected.front()) < 0) {
+            std::pop_heap(selected.begin(), selected.end(), comes_before);
+            selected.back() = candidate;
+            std::push_heap(selected.begin(), selected.end(), comes_before);
+        }
+    }
+    if (selected.empty()) {
+        return {};
+    }
+
+    std::sort_heap(selected.begin(), selected.end(), comes_before);
+    std::vector<size_t> page;
+    for (size_t i = skipped; i < selected.size(); ++i) {
+        page.push_back(m_matches.get_source_ndx(selected[i].position));
+    }
+    // Fewer rows than the offset means that all rows are skipped, the cursor then ends the paging.
+    m_cursor = std::move(selected.back());
+    m_has_cursor = true;
+    return page;
+}
+
+void ResultsPager::read_key(const Table& table, size_t row, std::vector<KeyValue>& key) const
+{
+    key.resize(m_sort_columns.size());
+    for (size_t i = 0; i < m_sort_columns.size(); ++i) {
+        size_t column = m_sort_columns[i].column;
+        KeyValue& value = key[i];
+        value.is_null = table.is_nullable(column) && table.is_null(column, row);
+        if (value.is_null) {
+            continue;
+        }
+        switch (m_column_types[i]) {
+            case type_Int:
+                value.int_value = table.get_int(column, row);
+                break;
+            case type_Bool:
+                value.int_value = table.get_bool(column, row) ? 1 : 0;
+                break;
+            case type_Float:
+                value.double_value = table.get_float(column, row);
+                break;
+            case type_Double:
+                value.double_value = table.get_double(column, row);
+                break;
+            case type_String: {
+                StringData string = table.get_string(column, row);
+                value.string_value.assign(string.data(), string.size());
+                break;
+            }
+            case type_Timestamp:
+                value.timestamp = table.get_timestamp(column, row);
+                break;
+            default:
+                REALM_UNREACHABLE();
+        }
+    }
+}
+
+int ResultsPager::compare(const Entry& a, const Entry& b) const noexcept
+{
+    for (size_t i = 0; i < m_sort_columns.size(); ++i) {
+        int result = compare_values(m_column_types[i], a.key[i], b.key[i]);
+        if (result != 0) {
+            return m_sort_columns[i].ascending ? result : -result;
+        }
+    }
+    return three_way_compare(a.position, b.position);
+}
+
+int ResultsPager::compare_values(DataType type, const KeyValue& a, const KeyValue& b) noexcept
+{
+    if (a.is_null || b.is_null) {
+        // Nulls come first.
+        return (a.is_null ? 0 : 1) - (b.is_null ? 0 : 1);
+    }
+    switch (type) {
+        case type_Int:
+        case type_Bool:
+            return three_way_compare(a.int_value, b.int_value);
+        case type_Float:
+        case type_Double:
+            return three_way_compare(a.double_value, b.double_value);
+        case type_String:
+            return three_way_compare(a.string_value, b.string_value);
+        case type_Timestamp:
+            return three_way_compare(a.timestamp, b.timestamp);
+        default:
+            REALM_UNREACHABLE();
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_RESULTS_PAGER_HPP
+#define REALM_JNI_IMPL_RESULTS_PAGER_HPP
+
+#include <string>
+#include <vector>
+
+#include <realm/query.hpp>
+#include <realm/table_view.hpp>
+#include <realm/timestamp.hpp>
+
+namespace realm {
+namespace _impl {
+
+// Pages through the rows matching a query in a given sort order without sorting all of them.
+//
+// The first page takes a snapshot of the matches in a TableView, the following pages continue from it without running
+// the query again. A sorted page is a bounded top-k selection over the snapshot: it reads the keys of the rows after
+// the last row returned, the cursor, and keeps only the page_size best in a heap. That's O(n log(page_size)) per page
+// with memory for a page of keys, instead of the O(n log(n)) sort and the accessors of a full sorted TableView.
+// Without a sort order, the pages follow the order of the snapshot.
+//
+// Core keeps the row indices of the TableView up to date when rows are moved, and detaches the rows which are
+// deleted. So every row matching the query when the first page was taken is returned once, except the rows deleted
+// since. Rows added after the first page are not returned. The sort keys are read again for every page, a row whose
+// sort key is changed between pages can be skipped or returned again.
+//
+// Only columns of the queried table can be used as sort keys: integers, booleans, floats, doubles, strings and dates.
+// Nulls come first in ascending order, strings are compared by their UTF-8 bytes.
+class ResultsPager {
+public:
+    struct SortColumn {
+        size_t column;
+        bool ascending;
+    };
+
+    // Throws std::invalid_argument if a column cannot be used as a sort key.
+    ResultsPager(Query query, std::vector<SortColumn> sort_columns, size_t offset, size_t page_size);
+
+    // Returns the row indices of the next page. An empty page means that all rows have been returned.
+    std::vector<size_t> next_page();
+
+private:
+    struct KeyValue {
+        bool is_null = true;
+        int64_t int_value = 0;
+        double double_value = 0;
+        Timestamp timestamp;
+        std::string string_value;
+    };
+
+    struct Entry {
+        std::vector<KeyValue> key;
+        // The position of the row in the snapshot, which also orders rows with the same sort key.
+        size_t position;
+    };
+
+    Query m_query;
+    std::vector<SortColumn> m_sort_columns;
+    std::vector<DataType> m_column_types;
+    size_t m_offset;
+    const size_t m_page_size;
+
+    bool m_has_snapshot = false;
+    TableView m_matches;
+    // The position in m_matches of the next row without a sort order.
+    size_t m_next_position = 0;
+    // The last row returned in the sort order, the next page starts after it.
+    bool m_has_cursor = false;
+    Entry m_cursor;
+
+    void take_snapshot();
+    std::vector<size_t> next_unsorted_page();
+    std::vector<size_t> next_sorted_page();
+
+    void read_key(const Table& table, size_t row, std::vector<KeyValue>& key) const;
+    // Negative if a comes before b in the sort order, positive if after.
+    int compare(const Entry& a, const Entry& b) const noexcept;
+    static int compare_values(DataType type, const KeyValue& a, const KeyValue& b) noexcept;
+};
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_RESULTS_PAGER_HPP
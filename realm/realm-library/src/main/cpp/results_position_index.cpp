@@ -0,0 +1,107 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "results_position_index.hpp"
+
+#include <realm/table_view.hpp>
+
+#include <shared_realm.hpp>
+
+using namespace realm;
+using namespace realm::_impl;
+
+size_t ResultsPositionIndex::index_of(Results& results, const Row& row)
+{
+    // Invalid results, detached rows and write transactions are left to Results::index_of().
+    if (!m_enabled || !results.is_valid() || !row.is_attached() || results.get_realm()->is_in_transaction()) {
+        return results.index_of(RowExpr(row));
+    }
+
+    using rf = realm::_impl::RealmFriend;
+    auto version = rf::get_shared_group(*results.get_realm()).get_version_of_current_transaction();
+    if (version != m_version) {
+        clear();
+        m_version = version;
+    }
+
+    if (!m_built) {
+        if (++m_lookups < 2) {
+            return results.index_of(RowExpr(row));
+        }
+        build(results);
+    }
+
+    if (row.get_table() != m_table) {
+        // Throws for a row from another table.
+        return results.index_of(RowExpr(row));
+    }
+    if (m_use_runs) {
+        return m_runs.find(row.get_index());
+    }
+    auto it = m_positions.find(row.get_index());
+    return it == m_positions.end() ? npos : it->second;
+}
+
+void ResultsPositionIndex::set_enabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (!enabled) {
+        clear();
+        // Releases the memory of the buckets and of the rows as well.
+        std::unordered_map<size_t, size_t>().swap(m_positions);
+        m_runs = RowIndexRuns();
+    }
+}
+
+void ResultsPositionIndex::clear()
+{
+    m_built = false;
+    m_lookups = 0;
+    m_runs.clear();
+    m_positions.clear();
+}
+
+void ResultsPositionIndex::build(Results& results)
+{
+    TableView view = results.get_tableview();
+    // The view of empty results has no table, rows are then always looked up by Results::index_of().
+    m_table = view.is_attached() ? &view.get_parent() : nullptr;
+    m_runs.clear();
+    m_positions.clear();
+
+    // Positions in the runs are counted from the first row, so a detached row also rules them out.
+    m_use_runs = true;
+    for (size_t i = 0; i < view.size(); ++i) {
+        if (!view.is_row_attached(i) || !m_runs.append(view.get_source_ndx(i))) {
+            m_use_runs = false;
+            break;
+        }
+    }
+    if (m_use_runs) {
+        m_built = true;
+        return;
+    }
+
+    m_runs.clear();
+    m_positions.reserve(view.size());
+    for (size_t i = 0; i < view.size(); ++i) {
+        if (view.is_row_attached(i)) {
+            // A list of links can contain the same object more than once, keep the first position like index_of().
+            m_positions.emplace(view.get_source_ndx(i), i);
+        }
+    }
+    m_built = true;
+}
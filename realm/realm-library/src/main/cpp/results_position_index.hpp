@@ -0,0 +1,68 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_RESULTS_POSITION_INDEX_HPP
+#define REALM_JNI_IMPL_RESULTS_POSITION_INDEX_HPP
+
+#include <unordered_map>
+
+#include <realm/group_shared.hpp>
+#include <realm/row.hpp>
+
+#include <results.hpp>
+
+#include "row_index_runs.hpp"
+
+namespace realm {
+namespace _impl {
+
+// Row index to position map of a Results, to answer repeated contains()/indexOf() calls in O(log n) instead of the
+// linear search of Results::index_of().
+//
+// The map costs memory for every row of the results, so it is only used once it has been enabled for the Results.
+// It is then built lazily from the second lookup on the same version of the Realm, so a single lookup doesn't pay for
+// it. Outside of a write transaction the rows of a Results can only change when the Realm advances to a new version,
+// which is when its TableView is re-synced, so the map is dropped whenever the version has changed. Inside a write
+// transaction the rows can change at any time and every lookup falls back to Results::index_of().
+//
+// Results in table order have increasing rows, they are kept in a RowIndexRuns which is much smaller than a hash map
+// for large results and is searched in O(log n). Other orders use the hash map.
+class ResultsPositionIndex {
+public:
+    // Returns the position of the row in the results or npos. Throws the same exceptions as Results::index_of().
+    size_t index_of(Results& results, const Row& row);
+
+    // Disabled by default. Disabling it frees the map.
+    void set_enabled(bool enabled);
+
+private:
+    bool m_enabled = false;
+    bool m_built = false;
+    size_t m_lookups = 0;
+    SharedGroup::VersionID m_version;
+    const Table* m_table = nullptr;
+    bool m_use_runs = false;
+    RowIndexRuns m_runs;
+    std::unordered_map<size_t, size_t> m_positions;
+
+    void build(Results& results);
+    void clear();
+};
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_RESULTS_POSITION_INDEX_HPP
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "row_index_runs.hpp"
+
+#include <algorithm>
+
+#include <realm/utilities.hpp>
+
+using namespace realm;
+using namespace realm::_impl;
+
+bool RowIndexRuns::append(size_t row)
+{
+    if (m_use_rows) {
+        if (!m_rows.empty() && row <= m_rows.back()) {
+            return false;
+        }
+        m_rows.push_back(row);
+        return true;
+    }
+
+    if (!m_runs.empty()) {
+        Run& last = m_runs.back();
+        size_t next_row = last.first_row + last.length;
+        if (row < next_row) {
+            return false;
+        }
+        if (row == next_row) {
+            ++last.length;
+            ++m_size;
+            return true;
+        }
+    }
+    m_runs.push_back(Run{row, m_size, 1});
+    ++m_size;
+    if (m_size >= min_rows_for_vector && m_runs.size() * 3 > m_size) {
+        move_runs_to_rows();
+    }
+    return true;
+}
+
+size_t RowIndexRuns::find(size_t row) const noexcept
+{
+    if (m_use_rows) {
+        auto it = std::lower_bound(m_rows.begin(), m_rows.end(), row);
+        return it != m_rows.end() && *it == row ? static_cast<size_t>(it - m_rows.begin()) : npos;
+    }
+
+    // The last run starting at or before the row.
+    auto it = std::upper_bound(m_runs.begin(), m_runs.end(), row,
+                               [](size_t r, const Run& run) { return r < run.first_row; });
+    if (it == m_runs.begin()) {
+        return npos;
+    }
+    --it;
+    size_t offset = row - it->first_row;
+    return offset < it->length ? it->first_position + offset : npos;
+}
+
+void RowIndexRuns::clear() noexcept
+{
+    m_runs.clear();
+    m_size = 0;
+    m_use_rows = false;
+    m_rows.clear();
+}
+
+void RowIndexRuns::move_runs_to_rows()
+{
+    m_rows.reserve(m_size);
+    for (auto& run : m_runs) {
+        for (size_t i = 0; i < run.length; ++i) {
+            m_rows.push_back(run.first_row + i);
+        }
+    }
+    std::vector<Run>().swap(m_runs);
+    m_use_rows = true;
+}
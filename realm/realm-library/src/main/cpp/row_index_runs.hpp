@@ -0,0 +1,68 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_ROW_INDEX_RUNS_HPP
+#define REALM_JNI_IMPL_ROW_INDEX_RUNS_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace realm {
+namespace _impl {
+
+// Strictly increasing row indices stored as runs of consecutive rows.
+//
+// The rows of results in table order are increasing and often clustered, e.g. all rows of a table or the rows matching
+// a range on an auto incremented field. A run of consecutive rows takes 3 words whatever its length, so 10 million
+// matches in a few runs use a few bytes instead of 80 MB as a vector of row indices, and even more as a hash map.
+//
+// Sparse rows don't compress: every run then costs 3 words for a single row. Once there are more runs than a third of
+// the rows, the rows are moved to a plain sorted vector of 1 word per row instead. The position of a row (rank) is a
+// binary search over the runs or the vector.
+class RowIndexRuns {
+public:
+    // Appends a row at the end. Returns false and leaves the rows unchanged if the row is not greater than the last
+    // one.
+    bool append(size_t row);
+
+    // Returns the position of the row or npos.
+    size_t find(size_t row) const noexcept;
+
+    void clear() noexcept;
+
+private:
+    struct Run {
+        size_t first_row;
+        size_t first_position;
+        size_t length;
+    };
+
+    // Runs are not given up for the first rows, which don't tell much about the clustering yet.
+    static constexpr size_t min_rows_for_vector = 64;
+
+    std::vector<Run> m_runs;
+    size_t m_size = 0;
+    // Used instead of the runs once they don't compress.
+    bool m_use_rows = false;
+    std::vector<size_t> m_rows;
+
+    void move_runs_to_rows();
+};
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_ROW_INDEX_RUNS_HPP
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "schema_cache.hpp"
+
+#include <stdexcept>
+
+#include <object_store.hpp>
+
+#include "java_binding_context.hpp"
+#include "java_object_batch.hpp"
+#include "util.hpp"
+
+using namespace realm;
+using namespace realm::_impl;
+
+namespace {
+
+const ObjectSchema& find_link_target(const Schema& schema, const Property& property)
+{
+    auto it = schema.find(property.object_type);
+    if (it == schema.end()) {
+        throw std::runtime_error(util::format("Class '%1' cannot be found in the schema.", property.object_type));
+    }
+    return *it;
+}
+
+SchemaCache* schema_cache_of(const SharedRealm& realm)
+{
+    if (!realm->m_binding_context) {
+        return nullptr;
+    }
+    return &static_cast<JavaBindingContext*>(realm->m_binding_context.get())->schema_cache();
+}
+
+} // anonymous namespace
+
+const ObjectSchema& SchemaCache::object_schema_for_table(const Schema& schema, const Table& table)
+{
+    // Keyed by the index of the table in the group, the accessor itself can be freed and its address reused. The
+    // class name of a hit is still compared, in case the tables have been moved around since.
+    size_t table_index = table.get_index_in_group();
+    auto it = m_table_classes.find(table_index);
+    if (it != m_table_classes.end() &&
+        ObjectStore::object_type_for_table_name(table.get_name()) == StringData(it->second->name)) {
+        return *it->second;
+    }
+    const ObjectSchema& object_schema = _impl::object_schema_for_table(schema, table);
+    m_table_classes[table_index] = &object_schema;
+    return object_schema;
+}
+
+const ObjectSchema& SchemaCache::link_target(const Schema& schema, const Property& property)
+{
+    auto it = m_link_targets.find(&property);
+    if (it != m_link_targets.end() && it->second->name == property.object_type) {
+        return *it->second;
+    }
+    const ObjectSchema& target = find_link_target(schema, property);
+    m_link_targets[&property] = &target;
+    return target;
+}
+
+const ObjectSchema& realm::_impl::object_schema_for_table(const SharedRealm& realm, const Table& table)
+{
+    if (SchemaCache* cache = schema_cache_of(realm)) {
+        return cache->object_schema_for_table(realm->schema(), table);
+    }
+    return object_schema_for_table(realm->schema(), table);
+}
+
+const ObjectSchema& realm::_impl::link_target(const SharedRealm& realm, const Property& property)
+{
+    if (SchemaCache* cache = schema_cache_of(realm)) {
+        return cache->link_target(realm->schema(), property);
+    }
+    return find_link_target(realm->schema(), property);
+}
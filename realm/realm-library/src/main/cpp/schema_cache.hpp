@@ -0,0 +1,66 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_JNI_IMPL_SCHEMA_CACHE_HPP
+#define REALM_JNI_IMPL_SCHEMA_CACHE_HPP
+
+#include <unordered_map>
+
+#include <object_schema.hpp>
+#include <schema.hpp>
+#include <shared_realm.hpp>
+
+namespace realm {
+namespace _impl {
+
+// Caches the lookups by name in the schema of a Realm which are done on the write paths: the class stored in a table
+// and the class a link property points to. Both are otherwise resolved by building and comparing strings for every
+// call, or every linked object.
+//
+// The cache is owned by the JavaBindingContext of the Realm and cleared when its schema changes, since the cached
+// classes point into Realm::schema(). Like the Realm, it must only be used on the thread of the Realm.
+class SchemaCache {
+public:
+    // Throws if the class is not part of the schema.
+    const ObjectSchema& object_schema_for_table(const Schema& schema, const Table& table);
+
+    // The class a link or a list of links points to.
+    const ObjectSchema& link_target(const Schema& schema, const Property& property);
+
+    void clear() noexcept
+    {
+        m_table_classes.clear();
+        m_link_targets.clear();
+    }
+
+private:
+    // Keyed by the index of the table in the group. The name of the cached class is checked before it is used.
+    std::unordered_map<size_t, const ObjectSchema*> m_table_classes;
+    // Properties might come from a copy of an ObjectSchema which has been freed since, the name of the cached target
+    // is checked before it is used.
+    std::unordered_map<const Property*, const ObjectSchema*> m_link_targets;
+};
+
+// Returns the schema of the class stored in the given table, through the cache of the Realm if it has one.
+const ObjectSchema& object_schema_for_table(const SharedRealm& realm, const Table& table);
+
+// Returns the schema of the class a link property points to, through the cache of the Realm if it has one.
+const ObjectSchema& link_target(const SharedRealm& realm, const Property& property);
+
+} // namespace _impl
+} // namespace realm
+
+#endif // REALM_JNI_IMPL_SCHEMA_CACHE_HPP
@@ -510,3 +510,21 @@ JStringAccessor::JStringAccessor(JNIEnv* env, jstring str)
         std::memset(tmp_char_array + m_size, 0, buf_size - m_size);
     }
 }
+
+size_t to_utf8(const jchar* data, size_t size, char* out)
+{
+    typedef Utf8x16<jchar, JcharTraits> Xcode;
+    const jchar* in_begin = data;
+    const jchar* in_end = data + size;
+    char* out_begin = out;
+    char* out_end = out + max_utf8_size(size);
+    size_t error_code;
+    if (!Xcode::to_utf8(in_begin, in_end, out_begin, out_end, error_code)) {
+        throw std::invalid_argument(string_to_hex("Failure when converting to UTF-8", data, size, error_code));
+    }
+    if (in_begin != in_end) {
+        throw std::invalid_argument(
+            string_to_hex("in_begin != in_end when converting to UTF-8", data, size, error_code));
+    }
+    return static_cast<size_t>(out_begin - out);
+}
@@ -449,6 +449,16 @@ std::string concat_stringdata(const char* message, realm::StringData data);
 
 jstring to_jstring(JNIEnv*, realm::StringData);
 
+// Converts UTF-16 code units to UTF-8, following the same rules as JStringAccessor. The output buffer must be at
+// least max_utf8_size(size) bytes. Returns the number of bytes written.
+size_t to_utf8(const jchar* data, size_t size, char* out); // throws
+
+inline size_t max_utf8_size(size_t utf16_size)
+{
+    // A code unit never takes more than 3 bytes, a surrogate pair takes 4.
+    return utf16_size * 3;
+}
+
 class JStringAccessor {
 public:
     JStringAccessor(JNIEnv*, jstring); // throws
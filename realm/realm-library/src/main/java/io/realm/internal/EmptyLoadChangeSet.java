@@ -72,6 +72,11 @@ public class EmptyLoadChangeSet extends OsCollectionChangeSet {
         return NO_RANGE_CHANGES;
     }
 
+    @Override
+    public int[] getMoves() {
+        return NO_INDEX_CHANGES;
+    }
+
     @Override
     public Throwable getError() {
         if (subscription != null && subscription.getState() == OsSubscription.SubscriptionState.ERROR) {
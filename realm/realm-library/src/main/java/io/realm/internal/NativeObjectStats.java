@@ -0,0 +1,126 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal;
+
+import java.util.Locale;
+
+/**
+ * Live count and estimated byte size of the native objects held by Java objects and waiting to be freed by the
+ * {@link FinalizerRunnable}. The numbers can be used to detect leaks of native resources or to see how much native
+ * memory is pending finalization.
+ * <p>
+ * The byte size is an estimation of the memory owned by the JNI objects themselves. Memory managed by Core, like the
+ * Realm file mapping, is not included.
+ */
+public final class NativeObjectStats {
+
+    // Used in JNI. Must be kept in sync with NativeObjectStats::Type in native_object_stats.hpp.
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_ROW = 0;
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_TABLE_VIEW = 1;
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_RESULTS = 2;
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_LIST = 3;
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_OBJECT = 4;
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_COLLECTION_CHANGE_SET = 5;
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_OBJECT_BUILDER = 6;
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_DESCRIPTOR_ORDERING = 7;
+    @SuppressWarnings("WeakerAccess")
+    public static final int NUM_TYPES = 8;
+
+    private static final String[] TYPE_NAMES = {
+            "Row",
+            "TableView",
+            "Results",
+            "List",
+            "Object",
+            "CollectionChangeSet",
+            "ObjectBuilder",
+            "DescriptorOrdering"
+    };
+
+    // {liveCount0, liveBytes0, liveCount1, liveBytes1, ...}
+    private final long[] stats;
+
+    private NativeObjectStats(long[] stats) {
+        this.stats = stats;
+    }
+
+    /**
+     * Takes a snapshot of the current native object counters.
+     */
+    public static NativeObjectStats snapshot() {
+        return new NativeObjectStats(nativeGetStats());
+    }
+
+    /**
+     * Returns the number of native objects of the given type which have not been freed yet.
+     *
+     * @param type one of the {@code TYPE_XXX} constants.
+     */
+    public long getLiveCount(int type) {
+        checkType(type);
+        return stats[type * 2];
+    }
+
+    /**
+     * Returns the estimated number of bytes held by native objects of the given type which have not been freed yet.
+     *
+     * @param type one of the {@code TYPE_XXX} constants.
+     */
+    public long getLiveBytes(int type) {
+        checkType(type);
+        return stats[type * 2 + 1];
+    }
+
+    /**
+     * Returns the estimated number of bytes held by all tracked native objects.
+     */
+    public long getTotalLiveBytes() {
+        long total = 0;
+        for (int i = 0; i < NUM_TYPES; i++) {
+            total += stats[i * 2 + 1];
+        }
+        return total;
+    }
+
+    private static void checkType(int type) {
+        if (type < 0 || type >= NUM_TYPES) {
+            throw new IllegalArgumentException("Invalid native object type: " + type);
+        }
+    }
+
+    @Override
+    public String toString() {
+        StringBuilder sb = new StringBuilder("NativeObjectStats{");
+        for (int i = 0; i < NUM_TYPES; i++) {
+            if (i != 0) {
+                sb.append(", ");
+            }
+            sb.append(String.format(Locale.US, "%s=%d/%dB", TYPE_NAMES[i], stats[i * 2], stats[i * 2 + 1]));
+        }
+        return sb.append('}').toString();
+    }
+
+    private static native long[] nativeGetStats();
+}
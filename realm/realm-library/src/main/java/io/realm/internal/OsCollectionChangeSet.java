@@ -28,6 +28,9 @@ import io.realm.internal.sync.OsSubscription;
  * OsCollectionChangeSet and read from it only when needed. Creating an Java object from JNI when the collection
  * notification arrives, is avoided since we also support the collection listeners without a change set parameter,
  * parsing the change set may not be necessary all the time.
+ * <p>
+ * The whole change set is encoded by JNI into a single {@code int[]} the first time it is read, all the getters then
+ * decode their part of it without calling JNI again.
  */
 public class OsCollectionChangeSet implements OrderedCollectionChangeSet, NativeObject {
 
@@ -38,6 +41,11 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
     public static final int TYPE_INSERTION = 1;
     @SuppressWarnings("WeakerAccess")
     public static final int TYPE_MODIFICATION = 2;
+    @SuppressWarnings("WeakerAccess")
+    public static final int TYPE_MOVE = 3;
+    // Number of ints before the ranges in the encoded change set: the number of ranges of each type and of moves.
+    @SuppressWarnings("WeakerAccess")
+    public static final int ENCODED_HEADER_LENGTH = 4;
     // Max array length is VM dependent. This is a safe value.
     // See http://stackoverflow.com/questions/3038392/do-java-arrays-have-a-maximum-size
     @SuppressWarnings({"WeakerAccess", "unused"})
@@ -48,6 +56,8 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
     private final boolean firstAsyncCallback;
     protected final OsSubscription subscription;
     protected final boolean isPartialRealm;
+    @Nullable
+    private int[] encoded;
 
     public OsCollectionChangeSet(long nativePtr, boolean firstAsyncCallback) {
         this(nativePtr, firstAsyncCallback, null, false);
@@ -71,7 +81,7 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
      */
     @Override
     public int[] getDeletions() {
-        return nativeGetIndices(nativePtr, TYPE_DELETION);
+        return getIndices(TYPE_DELETION);
     }
 
     /**
@@ -79,7 +89,7 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
      */
     @Override
     public int[] getInsertions() {
-        return nativeGetIndices(nativePtr, TYPE_INSERTION);
+        return getIndices(TYPE_INSERTION);
     }
 
     /**
@@ -87,7 +97,7 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
      */
     @Override
     public int[] getChanges() {
-        return nativeGetIndices(nativePtr, TYPE_MODIFICATION);
+        return getIndices(TYPE_MODIFICATION);
     }
 
     /**
@@ -95,7 +105,7 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
      */
     @Override
     public Range[] getDeletionRanges() {
-        return longArrayToRangeArray(nativeGetRanges(nativePtr, TYPE_DELETION));
+        return getRanges(TYPE_DELETION);
     }
 
     /**
@@ -103,7 +113,7 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
      */
     @Override
     public Range[] getInsertionRanges() {
-        return longArrayToRangeArray(nativeGetRanges(nativePtr, TYPE_INSERTION));
+        return getRanges(TYPE_INSERTION);
     }
 
     /**
@@ -111,7 +121,7 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
      */
     @Override
     public Range[] getChangeRanges() {
-        return longArrayToRangeArray(nativeGetRanges(nativePtr, TYPE_MODIFICATION));
+        return getRanges(TYPE_MODIFICATION);
     }
 
     @Override
@@ -156,21 +166,75 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
         return nativePtr == 0;
     }
 
-    // Convert long array returned by the nativeGetXxxRanges() to Range array.
-    private Range[] longArrayToRangeArray(int[] longArray) {
-        //noinspection ConstantConditions
-        if (longArray == null) {
-            // Returns a size 0 array so we know JNI gets called.
-            return new Range[0];
+    /**
+     * Returns the moves of this change set as pairs of indices: {@code [from1, to1, from2, to2, ...]}.
+     */
+    public int[] getMoves() {
+        int[] ints = getEncoded();
+        int offset = getSectionOffset(ints, TYPE_MOVE);
+        return Arrays.copyOfRange(ints, offset, offset + ints[TYPE_MOVE] * 2);
+    }
+
+    /**
+     * Merges two change sets delivered one after the other into one describing the changes of both. The given change
+     * sets are owned and freed by this call, they must not be wrapped in an {@link OsCollectionChangeSet}. The returned
+     * one must be handed over to a new {@link OsCollectionChangeSet}.
+     *
+     * @param earlierPtr the native pointer of the change set delivered first.
+     * @param laterPtr the native pointer of the change set delivered after it.
+     * @return the native pointer of the merged change set.
+     */
+    static long coalesce(long earlierPtr, long laterPtr) {
+        return nativeCoalesce(earlierPtr, laterPtr);
+    }
+
+    private int[] getEncoded() {
+        if (encoded == null) {
+            encoded = nativeEncode(nativePtr);
         }
+        return encoded;
+    }
 
-        Range[] ranges = new Range[longArray.length / 2];
+    // Returns the position of the first range of the given type in the encoded change set.
+    private static int getSectionOffset(int[] ints, int type) {
+        int offset = ENCODED_HEADER_LENGTH;
+        for (int i = 0; i < type; i++) {
+            offset += ints[i] * 2;
+        }
+        return offset;
+    }
+
+    private Range[] getRanges(int type) {
+        int[] ints = getEncoded();
+        int offset = getSectionOffset(ints, type);
+        Range[] ranges = new Range[ints[type]];
         for (int i = 0; i < ranges.length; i++) {
-            ranges[i] = new Range(longArray[i * 2], longArray[i * 2 + 1]);
+            ranges[i] = new Range(ints[offset + i * 2], ints[offset + i * 2 + 1]);
         }
         return ranges;
     }
 
+    private int[] getIndices(int type) {
+        int[] ints = getEncoded();
+        int offset = getSectionOffset(ints, type);
+        int count = ints[type];
+        int size = 0;
+        for (int i = 0; i < count; i++) {
+            size += ints[offset + i * 2 + 1];
+        }
+
+        int[] indices = new int[size];
+        int index = 0;
+        for (int i = 0; i < count; i++) {
+            int start = ints[offset + i * 2];
+            int length = ints[offset + i * 2 + 1];
+            for (int j = 0; j < length; j++) {
+                indices[index++] = start + j;
+            }
+        }
+        return indices;
+    }
+
     @Override
     public String toString() {
         if (nativePtr == 0)  {
@@ -204,9 +268,8 @@ public class OsCollectionChangeSet implements OrderedCollectionChangeSet, Native
 
     private native static long nativeGetFinalizerPtr();
 
-    // Returns the ranges as a long array. eg.: [startIndex1, length1, startIndex2, length2, ...]
-    private native static int[] nativeGetRanges(long nativePtr, int type);
+    // Encodes the change set, see io_realm_internal_OsCollectionChangeSet.cpp for the layout.
+    private native static int[] nativeEncode(long nativePtr);
 
-    // Returns the indices array.
-    private native static int[] nativeGetIndices(long nativePtr, int type);
+    private native static long nativeCoalesce(long earlierPtr, long laterPtr);
 }
@@ -6,6 +6,7 @@ import javax.annotation.Nullable;
 
 import io.realm.OrderedRealmCollectionChangeListener;
 import io.realm.RealmChangeListener;
+import io.realm.internal.core.QueryDescriptor;
 
 /**
  * Java wrapper of Object Store List class. This backs managed versions of RealmList.
@@ -168,6 +169,131 @@ public class OsList implements NativeObject, ObservableCollection {
         }
     }
 
+    // The bulk methods below write a whole array with one JNI call. The type and nullability of the list, the range
+    // and, for links, every target row index are checked before anything is written, so either all values are
+    // written or none. For the primitive arrays, {@code nulls} marks the null values and can be null if there are
+    // none.
+
+    public void addAllRows(long[] targetRowIndices) {
+        nativeAddAllRows(nativePtr, targetRowIndices);
+    }
+
+    public void setRangeRows(long pos, long[] targetRowIndices) {
+        nativeSetRangeRows(nativePtr, pos, targetRowIndices);
+    }
+
+    public void addAllLongs(long[] values, @Nullable boolean[] nulls) {
+        nativeAddAllLongs(nativePtr, values, nulls);
+    }
+
+    public void setRangeLongs(long pos, long[] values, @Nullable boolean[] nulls) {
+        nativeSetRangeLongs(nativePtr, pos, values, nulls);
+    }
+
+    public void addAllDoubles(double[] values, @Nullable boolean[] nulls) {
+        nativeAddAllDoubles(nativePtr, values, nulls);
+    }
+
+    public void setRangeDoubles(long pos, double[] values, @Nullable boolean[] nulls) {
+        nativeSetRangeDoubles(nativePtr, pos, values, nulls);
+    }
+
+    public void addAllFloats(float[] values, @Nullable boolean[] nulls) {
+        nativeAddAllFloats(nativePtr, values, nulls);
+    }
+
+    public void setRangeFloats(long pos, float[] values, @Nullable boolean[] nulls) {
+        nativeSetRangeFloats(nativePtr, pos, values, nulls);
+    }
+
+    public void addAllBooleans(boolean[] values, @Nullable boolean[] nulls) {
+        nativeAddAllBooleans(nativePtr, values, nulls);
+    }
+
+    public void setRangeBooleans(long pos, boolean[] values, @Nullable boolean[] nulls) {
+        nativeSetRangeBooleans(nativePtr, pos, values, nulls);
+    }
+
+    public void addAllBinaries(byte[][] values) {
+        nativeAddAllBinaries(nativePtr, values);
+    }
+
+    public void setRangeBinaries(long pos, byte[][] values) {
+        nativeSetRangeBinaries(nativePtr, pos, values);
+    }
+
+    public void addAllStrings(String[] values) {
+        nativeAddAllStrings(nativePtr, values);
+    }
+
+    public void setRangeStrings(long pos, String[] values) {
+        nativeSetRangeStrings(nativePtr, pos, values);
+    }
+
+    public void addAllDates(Date[] values) {
+        long[] times = new long[values.length];
+        boolean[] nulls = toTimes(values, times);
+        nativeAddAllDates(nativePtr, times, nulls);
+    }
+
+    public void setRangeDates(long pos, Date[] values) {
+        long[] times = new long[values.length];
+        boolean[] nulls = toTimes(values, times);
+        nativeSetRangeDates(nativePtr, pos, times, nulls);
+    }
+
+    // Fills times with the values in milliseconds and returns the null mask, or null if there are no null values.
+    @Nullable
+    private static boolean[] toTimes(Date[] values, long[] times) {
+        boolean[] nulls = null;
+        for (int i = 0; i < values.length; i++) {
+            Date value = values[i];
+            if (value == null) {
+                if (nulls == null) {
+                    nulls = new boolean[values.length];
+                }
+                nulls[i] = true;
+            } else {
+                times[i] = value.getTime();
+            }
+        }
+        return nulls;
+    }
+
+    // The bulk getters below copy values.length elements starting at start into values with one JNI call. For the
+    // primitive arrays, null elements are read as 0 or false and flagged in nulls, if it is given.
+
+    public void getRowIndices(long start, long[] targetRowIndices) {
+        nativeGetRowIndices(nativePtr, start, targetRowIndices);
+    }
+
+    public void getLongs(long start, long[] values, @Nullable boolean[] nulls) {
+        nativeGetLongs(nativePtr, start, values, nulls);
+    }
+
+    public void getDoubles(long start, double[] values, @Nullable boolean[] nulls) {
+        nativeGetDoubles(nativePtr, start, values, nulls);
+    }
+
+    public void getFloats(long start, float[] values, @Nullable boolean[] nulls) {
+        nativeGetFloats(nativePtr, start, values, nulls);
+    }
+
+    public void getBooleans(long start, boolean[] values, @Nullable boolean[] nulls) {
+        nativeGetBooleans(nativePtr, start, values, nulls);
+    }
+
+    /**
+     * Reads dates as milliseconds since the epoch.
+     */
+    public void getTimestamps(long start, long[] values, @Nullable boolean[] nulls) {
+        nativeGetTimestamps(nativePtr, start, values, nulls);
+    }
+
+    public void getStrings(long start, String[] values) {
+        nativeGetStrings(nativePtr, start, values);
+    }
+
     @Nullable
     public Object getValue(long pos) {
         return nativeGetValue(nativePtr, pos);
@@ -177,6 +303,31 @@ public class OsList implements NativeObject, ObservableCollection {
         nativeMove(nativePtr, sourceIndex, targetIndex);
     }
 
+    /**
+     * Reorders the list so that the element at {@code newOrder[i]} ends up at position {@code i}. This is done with at
+     * most {@code size() - 1} swaps and is much cheaper than moving the elements one by one.
+     *
+     * @param newOrder a permutation of the positions of the list.
+     * @throws IllegalArgumentException if {@code newOrder} is not a permutation of the list positions.
+     */
+    public void applyPermutation(int[] newOrder) {
+        nativeApplyPermutation(nativePtr, newOrder);
+    }
+
+    /**
+     * Sorts a list of objects in place by the fields of the given descriptor. The sort is stable.
+     */
+    public void sortBy(QueryDescriptor sortDescriptor) {
+        nativeSortBy(nativePtr, sortDescriptor);
+    }
+
+    /**
+     * Sorts a list of primitive values in place. The sort is stable.
+     */
+    public void sortValues(boolean ascending) {
+        nativeSortValues(nativePtr, ascending);
+    }
+
     public void remove(long index) {
         nativeRemove(nativePtr, index);
     }
@@ -216,6 +367,21 @@ public class OsList implements NativeObject, ObservableCollection {
         return targetTable;
     }
 
+    /**
+     * Restricts the change listeners of this list of objects to changes of the given fields, see
+     * {@link OsResults#setKeyPathFilter(String[])}.
+     *
+     * @param keyPaths the fields to listen to, or {@code null} or an empty array to listen to all fields.
+     * @throws IllegalArgumentException if a field doesn't exist.
+     * @throws IllegalStateException if this is a list of primitive values.
+     */
+    public void setKeyPathFilter(@Nullable String[] keyPaths) {
+        if (targetTable == null) {
+            throw new IllegalStateException("Key paths can only be used with a list of objects.");
+        }
+        nativeSetKeyPathFilter(nativePtr, OsResults.getKeyPathColumns(targetTable, keyPaths));
+    }
+
     public <T> void addListener(T observer, OrderedRealmCollectionChangeListener<T> listener) {
         if (observerPairs.isEmpty()) {
             nativeStartListening(nativePtr);
@@ -272,6 +438,12 @@ public class OsList implements NativeObject, ObservableCollection {
 
     private static native void nativeMove(long nativePtr, long sourceIndex, long targetIndex);
 
+    private static native void nativeApplyPermutation(long nativePtr, int[] newOrder);
+
+    private static native void nativeSortBy(long nativePtr, QueryDescriptor sortDescriptor);
+
+    private static native void nativeSortValues(long nativePtr, boolean ascending);
+
     private static native void nativeRemove(long nativePtr, long index);
 
     private static native void nativeRemoveAll(long nativePtr);
@@ -336,6 +508,59 @@ public class OsList implements NativeObject, ObservableCollection {
 
     private static native Object nativeGetValue(long nativePtr, long pos);
 
+    private static native void nativeAddAllRows(long nativePtr, long[] targetRowIndices);
+
+    private static native void nativeSetRangeRows(long nativePtr, long pos, long[] targetRowIndices);
+
+    private static native void nativeAddAllLongs(long nativePtr, long[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeSetRangeLongs(long nativePtr, long pos, long[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeAddAllDoubles(long nativePtr, double[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeSetRangeDoubles(long nativePtr, long pos, double[] values,
+                                                     @Nullable boolean[] nulls);
+
+    private static native void nativeAddAllFloats(long nativePtr, float[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeSetRangeFloats(long nativePtr, long pos, float[] values,
+                                                    @Nullable boolean[] nulls);
+
+    private static native void nativeAddAllBooleans(long nativePtr, boolean[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeSetRangeBooleans(long nativePtr, long pos, boolean[] values,
+                                                      @Nullable boolean[] nulls);
+
+    private static native void nativeAddAllBinaries(long nativePtr, byte[][] values);
+
+    private static native void nativeSetRangeBinaries(long nativePtr, long pos, byte[][] values);
+
+    private static native void nativeAddAllStrings(long nativePtr, String[] values);
+
+    private static native void nativeSetRangeStrings(long nativePtr, long pos, String[] values);
+
+    private static native void nativeAddAllDates(long nativePtr, long[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeSetRangeDates(long nativePtr, long pos, long[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeGetRowIndices(long nativePtr, long start, long[] targetRowIndices);
+
+    private static native void nativeGetLongs(long nativePtr, long start, long[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeGetDoubles(long nativePtr, long start, double[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeGetFloats(long nativePtr, long start, float[] values, @Nullable boolean[] nulls);
+
+    private static native void nativeGetBooleans(long nativePtr, long start, boolean[] values,
+                                                 @Nullable boolean[] nulls);
+
+    private static native void nativeGetTimestamps(long nativePtr, long start, long[] values,
+                                                   @Nullable boolean[] nulls);
+
+    private static native void nativeGetStrings(long nativePtr, long start, String[] values);
+
+    private static native void nativeSetKeyPathFilter(long nativePtr, long[] columnIndices);
+
     private native void nativeStartListening(long nativePtr);
 
     private native void nativeStopListening(long nativePtr);
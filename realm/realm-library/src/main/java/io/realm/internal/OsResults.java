@@ -19,6 +19,7 @@ package io.realm.internal;
 import java.util.Collections;
 import java.util.ConcurrentModificationException;
 import java.util.Date;
+import java.util.Locale;
 import java.util.NoSuchElementException;
 
 import javax.annotation.Nullable;
@@ -379,10 +380,48 @@ public class OsResults implements NativeObject, ObservableCollection {
         return new OsResults(sharedRealm, table, nativeSort(nativePtr, sortDescriptor));
     }
 
+    /**
+     * Creates a pager returning the rows of these results page by page, see {@link OsResultsPager}.
+     *
+     * @param sortDescriptor the sort order of the pages, or {@code null} to return the rows in table order.
+     * @param offset the number of rows to skip before the first page.
+     * @param pageSize the maximum number of rows of a page.
+     */
+    public OsResultsPager createPager(@Nullable QueryDescriptor sortDescriptor, long offset, long pageSize) {
+        return new OsResultsPager(this, sortDescriptor, offset, pageSize);
+    }
+
+    /**
+     * Sets the maximum memory in bytes the hash set of {@link #distinct(QueryDescriptor)} may use. For results which
+     * have been loaded already, distinct values are found by hashing the distinct fields in the current order of the
+     * results. If the hash set would need more memory than this limit, the distinct falls back to sorting the rows.
+     * The default limit is 8 MB.
+     *
+     * @param bytes the memory limit, or {@code 0} to always sort the rows.
+     * @throws IllegalArgumentException if {@code bytes} is negative.
+     */
+    public static void setHashDistinctMemoryLimit(long bytes) {
+        if (bytes < 0) {
+            throw new IllegalArgumentException("The memory limit cannot be negative: " + bytes);
+        }
+        nativeSetHashDistinctMemoryLimit(bytes);
+    }
+
     public OsResults distinct(QueryDescriptor distinctDescriptor) {
         return new OsResults(sharedRealm, table, nativeDistinct(nativePtr, distinctDescriptor));
     }
 
+    /**
+     * Enables a row to position map for {@link #contains(UncheckedRow)} and {@link #indexOf(UncheckedRow)}. It is
+     * built from the second lookup on the same version of the Realm, and makes the following lookups O(log n) instead
+     * of a linear search. The map is disabled by default since it costs memory for the rows of the results.
+     *
+     * @param enabled {@code true} to build the map for repeated lookups, {@code false} to free it.
+     */
+    public void setPositionIndexEnabled(boolean enabled) {
+        nativeSetPositionIndexEnabled(nativePtr, enabled);
+    }
+
     public boolean contains(UncheckedRow row) {
         return nativeContains(nativePtr, row.getNativePtr());
     }
@@ -575,6 +614,56 @@ public class OsResults implements NativeObject, ObservableCollection {
         });
     }
 
+    /**
+     * Sets several properties on all objects in the results. Properties are resolved and values checked once, and all
+     * assignments of an object are done before moving to the next one.
+     *
+     * @param columnIndices the columns to set, all values are read from the same columns in {@code values}.
+     * @param values the builder holding the new values. It is closed when this method returns.
+     * @throws IllegalArgumentException if a column doesn't exist or a value doesn't match the property type.
+     * @throws IllegalStateException if one of the columns is the primary key.
+     */
+    public void setMany(long[] columnIndices, OsObjectBuilder values) {
+        try {
+            nativeSetMany(nativePtr, columnIndices, values.getNativePtr());
+        } finally {
+            values.close();
+        }
+    }
+
+    /**
+     * Restricts the change listeners of these results to changes of the given fields. Modifications of other fields
+     * of the objects don't trigger the listeners anymore, insertions, deletions and moves always do. A path through a
+     * link, e.g. {@code "owner.name"}, is filtered by its link field, so any change of the linked objects triggers the
+     * listeners.
+     *
+     * @param keyPaths the fields to listen to, or {@code null} or an empty array to listen to all fields.
+     * @throws IllegalArgumentException if a field doesn't exist.
+     */
+    public void setKeyPathFilter(@Nullable String[] keyPaths) {
+        nativeSetKeyPathFilter(nativePtr, getKeyPathColumns(table, keyPaths));
+    }
+
+    // Converts the key paths of a listener filter to the column indices of their first field.
+    static long[] getKeyPathColumns(Table table, @Nullable String[] keyPaths) {
+        if (keyPaths == null) {
+            return new long[0];
+        }
+        long[] columns = new long[keyPaths.length];
+        for (int i = 0; i < keyPaths.length; i++) {
+            int separator = keyPaths[i].indexOf('.');
+            String fieldName = (separator == -1) ? keyPaths[i] : keyPaths[i].substring(0, separator);
+            long columnIndex = table.getColumnIndex(fieldName);
+            if (columnIndex == Table.NO_MATCH) {
+                throw new IllegalArgumentException(String.format(Locale.US,
+                        "Field '%s' of key path '%s' doesn't exist in '%s'.", fieldName, keyPaths[i],
+                        table.getClassName()));
+            }
+            columns[i] = columnIndex;
+        }
+        return columns;
+    }
+
     public <T> void addListener(T observer, OrderedRealmCollectionChangeListener<T> listener) {
         if (observerPairs.isEmpty()) {
             nativeStartListening(nativePtr);
@@ -677,6 +766,8 @@ public class OsResults implements NativeObject, ObservableCollection {
 
     private static native long nativeDistinct(long nativePtr, QueryDescriptor distinctDesc);
 
+    private static native void nativeSetHashDistinctMemoryLimit(long bytes);
+
     private static native boolean nativeDeleteFirst(long nativePtr);
 
     private static native boolean nativeDeleteLast(long nativePtr);
@@ -703,6 +794,10 @@ public class OsResults implements NativeObject, ObservableCollection {
 
     private static native void nativeSetList(long nativePtr, String fieldName, long builderNativePtr);
 
+    private static native void nativeSetMany(long nativePtr, long[] columnIndices, long builderNativePtr);
+
+    private static native void nativeSetKeyPathFilter(long nativePtr, long[] columnIndices);
+
     // Non-static, we need this OsResults object in JNI.
     private native void nativeStartListening(long nativePtr);
 
@@ -714,6 +809,8 @@ public class OsResults implements NativeObject, ObservableCollection {
 
     private static native long nativeIndexOf(long nativePtr, long rowNativePtr);
 
+    private static native void nativeSetPositionIndexEnabled(long nativePtr, boolean enabled);
+
     private static native boolean nativeIsValid(long nativePtr);
 
     private static native byte nativeGetMode(long nativePtr);
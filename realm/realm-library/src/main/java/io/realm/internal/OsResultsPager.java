@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.internal;
+
+import javax.annotation.Nullable;
+
+import io.realm.internal.core.QueryDescriptor;
+
+/**
+ * Pages through the rows of an {@link OsResults} in a given sort order without sorting all of them.
+ * <p>
+ * The first page takes a snapshot of the matches of the query. Every page then only selects its own rows from the
+ * snapshot, the ones following the last row returned, instead of sorting all matches. Each row matching the query at
+ * the first page is returned once, except rows deleted since. Rows added after the first page are not returned, and a
+ * row whose sort key is changed between pages can be skipped or returned again.
+ * <p>
+ * Only results of a query on a class without distinct or limit can be paged, and they can only be sorted by fields of
+ * the class itself. Any sort order of the results is replaced by the one given to the pager.
+ */
+public class OsResultsPager implements NativeObject {
+
+    private static final long nativeFinalizerPtr = nativeGetFinalizerPtr();
+
+    private final long nativePtr;
+    private final Table table;
+
+    /**
+     * @param results the results to page through.
+     * @param sortDescriptor the sort order of the pages, or {@code null} to return the rows in table order.
+     * @param offset the number of rows to skip before the first page.
+     * @param pageSize the maximum number of rows of a page.
+     * @throws IllegalArgumentException if the results cannot be paged in the given order.
+     */
+    OsResultsPager(OsResults results, @Nullable QueryDescriptor sortDescriptor, long offset, long pageSize) {
+        this.nativePtr = nativeCreate(results.getNativePtr(), sortDescriptor, offset, pageSize);
+        this.table = results.getTable();
+        table.getSharedRealm().context.addReference(this);
+    }
+
+    @Override
+    public long getNativePtr() {
+        return nativePtr;
+    }
+
+    @Override
+    public long getNativeFinalizerPtr() {
+        return nativeFinalizerPtr;
+    }
+
+    public Table getTable() {
+        return table;
+    }
+
+    /**
+     * Returns the row indices of the next page. An empty array means that all rows have been returned.
+     */
+    public long[] nextPage() {
+        return nativeNextPage(nativePtr);
+    }
+
+    private static native long nativeGetFinalizerPtr();
+
+    private static native long nativeCreate(long resultsPtr, @Nullable QueryDescriptor sortDescriptor, long offset,
+                                            long pageSize);
+
+    private static native long[] nativeNextPage(long nativePtr);
+}
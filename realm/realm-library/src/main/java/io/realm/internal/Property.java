@@ -136,7 +136,7 @@ public class Property implements NativeObject {
         return type | requiredFlag;
     }
 
-    private static RealmFieldType convertToRealmFieldType(int propertyType) {
+    public static RealmFieldType convertToRealmFieldType(int propertyType) {
         // Clear the nullable flag
         switch (propertyType & ~TYPE_NULLABLE) {
             case  TYPE_OBJECT:
@@ -111,7 +111,12 @@ public class SubscriptionAwareOsResults extends OsResults {
     @Override
     public void notifyChangeListeners(long nativeChangeSetPtr) {
         collectionChanged = true;
-        delayedNotificationPtr = nativeChangeSetPtr;
+        if (delayedNotificationPtr != 0 && nativeChangeSetPtr != 0) {
+            // Several change sets arrived before the delayed delivery, merge them so no change is lost.
+            delayedNotificationPtr = OsCollectionChangeSet.coalesce(delayedNotificationPtr, nativeChangeSetPtr);
+        } else if (nativeChangeSetPtr != 0) {
+            delayedNotificationPtr = nativeChangeSetPtr;
+        }
     }
 
 }
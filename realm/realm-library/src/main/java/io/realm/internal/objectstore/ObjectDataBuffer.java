@@ -0,0 +1,257 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.internal.objectstore;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayDeque;
+
+/**
+ * Serializes the values of one or more objects into a direct {@link ByteBuffer}, so they can be sent to native code
+ * in a single JNI call. The buffer is decoded by {@code JavaObjectDataReader}, see java_object_data_reader.hpp for the
+ * format.
+ * <p>
+ * Objects are written by calling the {@code addX()} methods for each column followed by {@link #endObject()}. Lists
+ * are written by calling {@link #startList(long, int)} followed by exactly {@code size} calls to the
+ * {@code addXItem()} methods.
+ * <p>
+ * The direct buffers are expensive to allocate, so they are pooled per thread and must be given back by calling
+ * {@link #release()} on the thread which created this object.
+ */
+final class ObjectDataBuffer {
+
+    // Used in JNI. Must be kept in sync with JavaObjectDataReader::Type in java_object_data_reader.hpp.
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_NULL = 0;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_INTEGER = 1;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_BOOLEAN = 2;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_FLOAT = 3;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_DOUBLE = 4;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_DATE = 5;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_STRING = 6;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_BINARY = 7;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_OBJECT = 8;
+    @SuppressWarnings("WeakerAccess")
+    static final byte TYPE_LIST = 9;
+    @SuppressWarnings("WeakerAccess")
+    static final int END_OF_OBJECT = -1;
+
+    private static final int INITIAL_CAPACITY = 512;
+    // Bigger buffers are not pooled to avoid holding on to a lot of native memory.
+    private static final int MAX_POOLED_CAPACITY = 64 * 1024;
+    // Builders can be nested when copying an object graph, but rarely deeper than a few levels.
+    private static final int MAX_POOLED_BUFFERS = 4;
+
+    private static final ThreadLocal<ArrayDeque<ByteBuffer>> bufferPool = new ThreadLocal<ArrayDeque<ByteBuffer>>() {
+        @Override
+        protected ArrayDeque<ByteBuffer> initialValue() {
+            return new ArrayDeque<>();
+        }
+    };
+
+    private ByteBuffer buffer;
+
+    ObjectDataBuffer() {
+        ByteBuffer pooled = bufferPool.get().pollLast();
+        buffer = (pooled != null) ? pooled : allocate(INITIAL_CAPACITY);
+    }
+
+    private static ByteBuffer allocate(int capacity) {
+        return ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
+    }
+
+    /**
+     * Returns the direct buffer holding the data. It is only valid until the next write.
+     */
+    ByteBuffer getBuffer() {
+        return buffer;
+    }
+
+    /**
+     * Returns the number of bytes written so far.
+     */
+    long size() {
+        return buffer.position();
+    }
+
+    void addNull(long columnIndex) {
+        writeColumn(columnIndex);
+        addNullItem();
+    }
+
+    void addInteger(long columnIndex, long val) {
+        writeColumn(columnIndex);
+        addIntegerItem(val);
+    }
+
+    void addString(long columnIndex, String val) {
+        writeColumn(columnIndex);
+        addStringItem(val);
+    }
+
+    void addFloat(long columnIndex, float val) {
+        writeColumn(columnIndex);
+        addFloatItem(val);
+    }
+
+    void addDouble(long columnIndex, double val) {
+        writeColumn(columnIndex);
+        addDoubleItem(val);
+    }
+
+    void addBoolean(long columnIndex, boolean val) {
+        writeColumn(columnIndex);
+        addBooleanItem(val);
+    }
+
+    void addByteArray(long columnIndex, byte[] val) {
+        writeColumn(columnIndex);
+        addByteArrayItem(val);
+    }
+
+    void addDate(long columnIndex, long val) {
+        writeColumn(columnIndex);
+        addDateItem(val);
+    }
+
+    void addObject(long columnIndex, long rowPtr) {
+        writeColumn(columnIndex);
+        addObjectItem(rowPtr);
+    }
+
+    void startList(long columnIndex, int size) {
+        writeColumn(columnIndex);
+        ensureCapacity(5);
+        buffer.put(TYPE_LIST);
+        buffer.putInt(size);
+    }
+
+    void addNullItem() {
+        ensureCapacity(1);
+        buffer.put(TYPE_NULL);
+    }
+
+    void addIntegerItem(long val) {
+        ensureCapacity(9);
+        buffer.put(TYPE_INTEGER);
+        buffer.putLong(val);
+    }
+
+    void addStringItem(String val) {
+        int length = val.length();
+        ensureCapacity(5 + length * 2L);
+        buffer.put(TYPE_STRING);
+        buffer.putInt(length);
+        for (int i = 0; i < length; i++) {
+            buffer.putChar(val.charAt(i));
+        }
+    }
+
+    void addFloatItem(float val) {
+        ensureCapacity(5);
+        buffer.put(TYPE_FLOAT);
+        buffer.putFloat(val);
+    }
+
+    void addDoubleItem(double val) {
+        ensureCapacity(9);
+        buffer.put(TYPE_DOUBLE);
+        buffer.putDouble(val);
+    }
+
+    void addBooleanItem(boolean val) {
+        ensureCapacity(2);
+        buffer.put(TYPE_BOOLEAN);
+        buffer.put(val ? (byte) 1 : (byte) 0);
+    }
+
+    void addByteArrayItem(byte[] val) {
+        ensureCapacity(5L + val.length);
+        buffer.put(TYPE_BINARY);
+        buffer.putInt(val.length);
+        buffer.put(val);
+    }
+
+    void addDateItem(long val) {
+        ensureCapacity(9);
+        buffer.put(TYPE_DATE);
+        buffer.putLong(val);
+    }
+
+    void addObjectItem(long rowPtr) {
+        ensureCapacity(9);
+        buffer.put(TYPE_OBJECT);
+        buffer.putLong(rowPtr);
+    }
+
+    /**
+     * Marks the end of the current object. Another object of the same class can be written after this.
+     */
+    void endObject() {
+        ensureCapacity(4);
+        buffer.putInt(END_OF_OBJECT);
+    }
+
+    /**
+     * Discards all the data written so far.
+     */
+    void reset() {
+        buffer.clear();
+    }
+
+    /**
+     * Gives the buffer back to the pool of the calling thread. This object cannot be used afterwards.
+     */
+    void release() {
+        if (buffer == null) {
+            return;
+        }
+        ArrayDeque<ByteBuffer> pool = bufferPool.get();
+        if (buffer.capacity() <= MAX_POOLED_CAPACITY && pool.size() < MAX_POOLED_BUFFERS) {
+            buffer.clear();
+            pool.addLast(buffer);
+        }
+        buffer = null;
+    }
+
+    private void writeColumn(long columnIndex) {
+        ensureCapacity(4);
+        buffer.putInt((int) columnIndex);
+    }
+
+    private void ensureCapacity(long bytes) {
+        if (buffer.remaining() >= bytes) {
+            return;
+        }
+        long required = buffer.position() + bytes;
+        if (required > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("Too much object data: " + required + " bytes.");
+        }
+        int newCapacity = (int) Math.min(Integer.MAX_VALUE, Math.max(required, buffer.capacity() * 2L));
+        ByteBuffer newBuffer = allocate(newCapacity);
+        buffer.flip();
+        newBuffer.put(buffer);
+        buffer = newBuffer;
+    }
+}
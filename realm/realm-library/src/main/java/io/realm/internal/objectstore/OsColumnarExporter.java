@@ -0,0 +1,209 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.internal.objectstore;
+
+import java.io.Closeable;
+import java.nio.ByteBuffer;
+import java.util.Locale;
+
+import io.realm.RealmFieldType;
+import io.realm.internal.OsResults;
+import io.realm.internal.Property;
+
+/**
+ * Exports properties of the objects in an {@link OsResults} as columns using the Apache Arrow memory layout, so they
+ * can be handed over to vectorized code without any conversion. Each {@link Column} is made of up to three buffers:
+ * <ul>
+ *     <li>The validity bitmap, one bit per object in least significant bit order, {@code 0} for {@code null}. It is
+ *     empty if the column doesn't contain any {@code null}.</li>
+ *     <li>The values: {@code int64} for integers, bit packed booleans, {@code float32}, {@code float64} and
+ *     {@code int64} milliseconds since the epoch for dates. For strings and binaries, the {@code int32} offsets of
+ *     each value in the data buffer, one more than the number of objects.</li>
+ *     <li>The data, with the UTF-8 strings or the bytes. Only used by strings and binaries.</li>
+ * </ul>
+ * The offsets of the buffers are relative to the start of the output and are all multiples of 64 bytes. Values are
+ * written in the native byte order, which is little endian on all supported ABIs.
+ * <p>
+ * The objects are taken from a snapshot of the results when the exporter is created and the layout is computed right
+ * away, so {@link #getRequiredSize()} can be used to allocate the output. Any direct {@link ByteBuffer} can be used,
+ * including a {@link java.nio.MappedByteBuffer} to write the columns straight to a memory-mapped file.
+ * <p>
+ * The exporter must be used on the thread of the Realm and closed when done.
+ */
+public final class OsColumnarExporter implements Closeable {
+
+    // Must be kept in sync with the layout returned by nativeGetLayout.
+    private static final int LAYOUT_HEADER_SIZE = 2;
+    private static final int LAYOUT_COLUMN_SIZE = 8;
+
+    /**
+     * The layout of one exported property. Offsets and sizes are in bytes.
+     */
+    public static final class Column {
+        private final String name;
+        private final RealmFieldType fieldType;
+        private final boolean nullable;
+        private final long nullCount;
+        private final long validityOffset;
+        private final long validitySize;
+        private final long valuesOffset;
+        private final long valuesSize;
+        private final long dataOffset;
+        private final long dataSize;
+
+        private Column(String name, long[] layout, int start) {
+            this.name = name;
+            int propertyType = (int) layout[start];
+            this.fieldType = Property.convertToRealmFieldType(propertyType);
+            this.nullable = (propertyType & Property.TYPE_NULLABLE) != 0;
+            this.nullCount = layout[start + 1];
+            this.validityOffset = layout[start + 2];
+            this.validitySize = layout[start + 3];
+            this.valuesOffset = layout[start + 4];
+            this.valuesSize = layout[start + 5];
+            this.dataOffset = layout[start + 6];
+            this.dataSize = layout[start + 7];
+        }
+
+        public String getName() {
+            return name;
+        }
+
+        public RealmFieldType getFieldType() {
+            return fieldType;
+        }
+
+        public boolean isNullable() {
+            return nullable;
+        }
+
+        public long getNullCount() {
+            return nullCount;
+        }
+
+        public long getValidityOffset() {
+            return validityOffset;
+        }
+
+        /**
+         * Returns the size of the validity bitmap, {@code 0} if the column doesn't contain any {@code null}.
+         */
+        public long getValiditySize() {
+            return validitySize;
+        }
+
+        public long getValuesOffset() {
+            return valuesOffset;
+        }
+
+        public long getValuesSize() {
+            return valuesSize;
+        }
+
+        public long getDataOffset() {
+            return dataOffset;
+        }
+
+        /**
+         * Returns the size of the data buffer, always {@code 0} if the column is neither a string nor a binary.
+         */
+        public long getDataSize() {
+            return dataSize;
+        }
+    }
+
+    private long exporterPtr;
+    private final long rowCount;
+    private final long requiredSize;
+    private final Column[] columns;
+
+    /**
+     * @param properties the names of the exported properties, in the order of the columns.
+     * @throws IllegalArgumentException if a property doesn't exist or is a link or a list.
+     */
+    public OsColumnarExporter(OsResults results, String[] properties) {
+        if (properties.length == 0) {
+            throw new IllegalArgumentException("At least one property must be exported.");
+        }
+        exporterPtr = nativeCreate(results.getNativePtr(), properties);
+        long[] layout = nativeGetLayout(exporterPtr);
+        rowCount = layout[0];
+        requiredSize = layout[1];
+        columns = new Column[properties.length];
+        for (int i = 0; i < properties.length; i++) {
+            columns[i] = new Column(properties[i], layout, LAYOUT_HEADER_SIZE + i * LAYOUT_COLUMN_SIZE);
+        }
+    }
+
+    /**
+     * Returns the number of objects, which is the length of all columns.
+     */
+    public long getRowCount() {
+        return rowCount;
+    }
+
+    /**
+     * Returns the number of bytes needed to write all the columns.
+     */
+    public long getRequiredSize() {
+        return requiredSize;
+    }
+
+    public int getColumnCount() {
+        return columns.length;
+    }
+
+    public Column getColumn(int index) {
+        return columns[index];
+    }
+
+    /**
+     * Writes all the columns into a direct buffer, starting at its position. The position is moved past the columns.
+     *
+     * @throws IllegalArgumentException if the buffer is not direct or has less than {@link #getRequiredSize()} bytes
+     * remaining.
+     * @throws IllegalStateException if the objects have been changed in a write transaction since the exporter was
+     * created and don't fit the layout anymore.
+     */
+    public void writeTo(ByteBuffer buffer) {
+        if (exporterPtr == 0) {
+            throw new IllegalStateException("The columnar exporter has been closed.");
+        }
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("The columns can only be written into a direct ByteBuffer.");
+        }
+        if (buffer.remaining() < requiredSize) {
+            throw new IllegalArgumentException(String.format(Locale.US,
+                    "The columns need %d bytes, but only %d bytes are remaining in the buffer.",
+                    requiredSize, buffer.remaining()));
+        }
+        nativeWrite(exporterPtr, buffer, buffer.position(), requiredSize);
+        buffer.position(buffer.position() + (int) requiredSize);
+    }
+
+    @Override
+    public void close() {
+        if (exporterPtr != 0) {
+            nativeDestroy(exporterPtr);
+            exporterPtr = 0;
+        }
+    }
+
+    private static native long nativeCreate(long resultsPtr, String[] properties);
+    private static native void nativeDestroy(long exporterPtr);
+    private static native long[] nativeGetLayout(long exporterPtr);
+    private static native void nativeWrite(long exporterPtr, ByteBuffer buffer, long offset, long size);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.internal.objectstore;
+
+import java.nio.ByteBuffer;
+
+import io.realm.internal.Table;
+
+/**
+ * Writes objects given as columns, in the Apache Arrow memory layout written by {@link OsColumnarExporter}, into a
+ * table. Each column is mapped to its property once and written in a single pass in native code, so importing a batch
+ * costs one JNI call no matter how many objects it contains.
+ * <p>
+ * Columns are matched by the name of the properties in the Realm file. Integers, booleans, floats, doubles, dates,
+ * strings and binaries are supported. Properties without a column get their default value when a new object is
+ * created and keep their current value when an existing object is updated.
+ * <p>
+ * Must be called inside a write transaction. All buffers are checked against the schema before anything is written.
+ */
+public final class OsColumnarImporter {
+
+    /**
+     * The buffers of one column. Offsets are relative to the position of the imported buffer and sizes are in bytes.
+     */
+    public static final class Column {
+        private final String name;
+        private final long[] layout;
+
+        /**
+         * @param name the name of the property.
+         * @param validityOffset the offset of the validity bitmap.
+         * @param validitySize the size of the validity bitmap, {@code 0} if the column doesn't contain {@code null}.
+         * @param valuesOffset the offset of the values, or of the {@code int32} offsets for strings and binaries.
+         * @param valuesSize the size of the values.
+         * @param dataOffset the offset of the data of strings and binaries.
+         * @param dataSize the size of the data of strings and binaries, {@code 0} for other types.
+         */
+        public Column(String name, long validityOffset, long validitySize, long valuesOffset, long valuesSize,
+                      long dataOffset, long dataSize) {
+            this.name = name;
+            this.layout = new long[] {validityOffset, validitySize, valuesOffset, valuesSize, dataOffset, dataSize};
+        }
+
+        /**
+         * Creates the description of a column exported by {@link OsColumnarExporter}.
+         */
+        public static Column from(OsColumnarExporter.Column column) {
+            return new Column(column.getName(), column.getValidityOffset(), column.getValiditySize(),
+                    column.getValuesOffset(), column.getValuesSize(), column.getDataOffset(), column.getDataSize());
+        }
+    }
+
+    // Must be kept in sync with io_realm_internal_objectstore_OsColumnarImporter.cpp.
+    private static final int LAYOUT_COLUMN_SIZE = 6;
+
+    private OsColumnarImporter() {
+    }
+
+    /**
+     * Imports columns stored in a direct buffer, starting at its position.
+     *
+     * @param rowCount the number of objects, which is the length of all columns.
+     * @param updateExistingObjects if {@code true}, objects with an existing primary key are updated, otherwise a
+     * {@link io.realm.exceptions.RealmPrimaryKeyConstraintException} is thrown. The primary key must be one of the
+     * columns if the class has one.
+     * @return the number of objects created.
+     * @throws IllegalArgumentException if the buffer is not direct, a column doesn't match its property or a buffer is
+     * out of range.
+     */
+    public static long importColumns(Table table, ByteBuffer buffer, long rowCount, Column[] columns,
+                                     boolean updateExistingObjects) {
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("The columns must be stored in a direct ByteBuffer.");
+        }
+        String[] names = new String[columns.length];
+        long[] layout = new long[columns.length * LAYOUT_COLUMN_SIZE];
+        for (int i = 0; i < columns.length; i++) {
+            names[i] = columns[i].name;
+            System.arraycopy(columns[i].layout, 0, layout, i * LAYOUT_COLUMN_SIZE, LAYOUT_COLUMN_SIZE);
+        }
+        return nativeImport(table.getSharedRealm().getNativePtr(), table.getNativePtr(), buffer, buffer.position(),
+                rowCount, names, layout, updateExistingObjects);
+    }
+
+    private static native long nativeImport(long sharedRealmPtr, long tablePtr, ByteBuffer buffer, long bufferOffset,
+                                            long rowCount, String[] properties, long[] layout,
+                                            boolean updateExistingObjects);
+}
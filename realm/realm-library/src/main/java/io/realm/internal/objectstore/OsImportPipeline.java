@@ -0,0 +1,222 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.internal.objectstore;
+
+import java.io.Closeable;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Set;
+import java.util.concurrent.ArrayBlockingQueue;
+import java.util.concurrent.BlockingQueue;
+
+import io.realm.ImportFlag;
+import io.realm.internal.OsSharedRealm;
+import io.realm.internal.Table;
+
+/**
+ * Imports objects of a single class while keeping the work done by the thread holding the write transaction to a
+ * minimum.
+ * <p>
+ * Producer threads fill builders from {@link #newBuilder()} with any number of objects (see
+ * {@link OsObjectBuilder#nextObject()}) and hand them over with {@link #submit(OsObjectBuilder)}. This decodes the
+ * values, transcodes the strings to UTF-8 and validates everything against the schema of the class, outside of any
+ * transaction. The writer thread then only has to call `Object::create()` for the prepared objects, using
+ * {@link #writeReadyBatches(boolean)} or {@link #writeNextBatch(boolean)}. This shortens the time the write lock is
+ * held, and with it the time other processes have to wait for it.
+ * <p>
+ * The pipeline must be created, written and closed on the thread of the Realm, and the writes must happen inside a
+ * write transaction. {@link #newBuilder()} and {@link #submit(OsObjectBuilder)} can be called from any thread until
+ * the pipeline is closed. Links added to the builders must refer to objects of the Realm instance the batches are
+ * written with.
+ * <p>
+ * At most {@code capacity} prepared batches are kept waiting, {@link #submit(OsObjectBuilder)} blocks when the writer
+ * is falling behind.
+ */
+public final class OsImportPipeline implements Closeable {
+
+    private final Table table;
+    private final long maxColumnIndex;
+    private final Set<ImportFlag> flags;
+    private final long sharedRealmPtr;
+    private final long tablePtr;
+    private final boolean ignoreFieldsWithSameValue;
+    // Copy of the schema of the class, used by the producer threads to validate the objects.
+    private final long objectSchemaPtr;
+    private final BlockingQueue<Long> readyBatches;
+    // Guards closed and activeSubmits, so close() can wait for the producers which are still inside submit().
+    private final Object lock = new Object();
+    private volatile boolean closed = false;
+    private int activeSubmits = 0;
+
+    public OsImportPipeline(Table table, long maxColumnIndex, Set<ImportFlag> flags, int capacity) {
+        OsSharedRealm sharedRealm = table.getSharedRealm();
+        this.table = table;
+        this.maxColumnIndex = maxColumnIndex;
+        this.flags = flags;
+        this.sharedRealmPtr = sharedRealm.getNativePtr();
+        this.tablePtr = table.getNativePtr();
+        this.ignoreFieldsWithSameValue = flags.contains(ImportFlag.CHECK_SAME_VALUES_BEFORE_SET);
+        this.readyBatches = new ArrayBlockingQueue<Long>(capacity);
+        this.objectSchemaPtr = nativeCreateObjectSchema(sharedRealmPtr, tablePtr);
+    }
+
+    /**
+     * Returns a new builder for the objects of this pipeline. Can be called from any thread.
+     */
+    public OsObjectBuilder newBuilder() {
+        checkNotClosed();
+        // The builder only reads the native pointers of the table, it never calls into it.
+        return new OsObjectBuilder(table, maxColumnIndex, flags);
+    }
+
+    /**
+     * Prepares all objects added to the builder and queues them for the writer thread. The builder is closed
+     * afterwards. Can be called from any thread.
+     *
+     * @throws IllegalArgumentException if the value of a property doesn't match the schema. No object of the builder
+     * is queued in that case.
+     * @throws InterruptedException if interrupted while waiting for the writer to catch up.
+     */
+    public void submit(OsObjectBuilder builder) throws InterruptedException {
+        boolean entered = false;
+        try {
+            long batchPtr;
+            try {
+                synchronized (lock) {
+                    checkNotClosed();
+                    activeSubmits++;
+                    entered = true;
+                }
+                ObjectDataBuffer data = builder.finishObjects();
+                batchPtr = nativePrepareBatch(objectSchemaPtr, builder.getColumnCount(), data.getBuffer(),
+                        data.size());
+            } finally {
+                builder.close();
+            }
+            try {
+                readyBatches.put(batchPtr);
+            } catch (InterruptedException e) {
+                nativeDestroyBatch(batchPtr);
+                throw e;
+            }
+        } finally {
+            if (entered) {
+                synchronized (lock) {
+                    activeSubmits--;
+                    lock.notifyAll();
+                }
+            }
+        }
+    }
+
+    /**
+     * Creates or updates the objects of all batches prepared so far, without waiting for more. Must be called inside
+     * a write transaction.
+     *
+     * @param updateExistingObjects if {@code true}, objects with an existing primary key are updated, otherwise they
+     * are always created.
+     * @return the row indices of the created or updated objects, in the order they were submitted.
+     */
+    public long[] writeReadyBatches(boolean updateExistingObjects) {
+        List<Long> batches = new ArrayList<Long>();
+        readyBatches.drainTo(batches);
+        long[] batchPtrs = new long[batches.size()];
+        for (int i = 0; i < batchPtrs.length; i++) {
+            batchPtrs[i] = batches.get(i);
+        }
+        return writeBatches(batchPtrs, updateExistingObjects);
+    }
+
+    /**
+     * Waits for the next prepared batch and creates or updates its objects. Must be called inside a write
+     * transaction.
+     *
+     * @param updateExistingObjects if {@code true}, objects with an existing primary key are updated, otherwise they
+     * are always created.
+     * @return the row indices of the created or updated objects, in the order they were added to the builder.
+     * @throws InterruptedException if interrupted while waiting.
+     */
+    public long[] writeNextBatch(boolean updateExistingObjects) throws InterruptedException {
+        return writeBatches(new long[] {readyBatches.take()}, updateExistingObjects);
+    }
+
+    private long[] writeBatches(long[] batchPtrs, boolean updateExistingObjects) {
+        try {
+            checkNotClosed();
+            return nativeWriteBatches(sharedRealmPtr, tablePtr, batchPtrs, updateExistingObjects,
+                    updateExistingObjects && ignoreFieldsWithSameValue);
+        } finally {
+            // The batches have been taken from the queue, they are freed here even if writing them failed.
+            for (long batchPtr : batchPtrs) {
+                nativeDestroyBatch(batchPtr);
+            }
+        }
+    }
+
+    /**
+     * Frees the batches which have not been written and the copy of the schema. Producers still inside
+     * {@link #submit(OsObjectBuilder)} are waited for, the batches they queue in the meantime are freed as well.
+     */
+    @Override
+    public void close() {
+        boolean interrupted = false;
+        synchronized (lock) {
+            if (closed) {
+                return;
+            }
+            closed = true;
+            // Keep draining the queue while waiting, a producer may be blocked on a full queue.
+            destroyReadyBatches();
+            while (activeSubmits > 0) {
+                try {
+                    lock.wait(10);
+                } catch (InterruptedException e) {
+                    interrupted = true;
+                }
+                destroyReadyBatches();
+            }
+        }
+        nativeDestroyObjectSchema(objectSchemaPtr);
+        if (interrupted) {
+            Thread.currentThread().interrupt();
+        }
+    }
+
+    private void destroyReadyBatches() {
+        Long batchPtr;
+        while ((batchPtr = readyBatches.poll()) != null) {
+            nativeDestroyBatch(batchPtr);
+        }
+    }
+
+    private void checkNotClosed() {
+        if (closed) {
+            throw new IllegalStateException("The import pipeline has been closed.");
+        }
+    }
+
+    private static native long nativeCreateObjectSchema(long sharedRealmPtr, long tablePtr);
+    private static native void nativeDestroyObjectSchema(long objectSchemaPtr);
+    private static native long nativePrepareBatch(long objectSchemaPtr, long columnCount, ByteBuffer buffer,
+                                                  long bufferSize);
+    private static native void nativeDestroyBatch(long batchPtr);
+    private static native long[] nativeWriteBatches(long sharedRealmPtr,
+                                                    long tablePtr,
+                                                    long[] batchPtrs,
+                                                    boolean updateExistingObjects,
+                                                    boolean ignoreFieldsWithSameValue);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.internal.objectstore;
+
+import java.io.Closeable;
+import java.nio.ByteBuffer;
+
+import javax.annotation.Nullable;
+
+import io.realm.internal.OsResults;
+
+/**
+ * Exports the objects of an {@link OsResults} as a JSON array, incrementally. Unlike {@link OsResults#toJSON(int)},
+ * the JSON is never held in memory as a whole: it is either written to a file descriptor with {@link #writeTo(int)}
+ * or read chunk by chunk into buffers provided by the caller with {@link #read(ByteBuffer)}.
+ * <p>
+ * The objects are taken from a snapshot of the results when the exporter is created. The output uses the format read
+ * by {@link OsJsonImporter}: dates are written in ISO 8601 format, binaries as Base64 encoded strings, and links as
+ * nested objects up to the given depth. Links further away are left out.
+ * <p>
+ * The exporter must be used on the thread of the Realm and closed when done.
+ */
+public final class OsJsonExporter implements Closeable {
+
+    private long exporterPtr;
+
+    /**
+     * @param properties the names of the properties written for each object, or {@code null} for all of them.
+     * @param linkDepth how many levels of links are written as nested objects, {@code 0} to leave out all links.
+     * @throws IllegalArgumentException if a property doesn't exist or the depth is negative.
+     */
+    public OsJsonExporter(OsResults results, @Nullable String[] properties, int linkDepth) {
+        if (linkDepth < 0) {
+            throw new IllegalArgumentException("The link depth cannot be negative: " + linkDepth);
+        }
+        exporterPtr = nativeCreate(results.getNativePtr(), properties, linkDepth);
+    }
+
+    /**
+     * Reads the next bytes of the JSON into a direct buffer, from its position up to its limit. The position is moved
+     * past the bytes read.
+     *
+     * @return the number of bytes read, or {@code -1} if everything has been read already.
+     * @throws IllegalArgumentException if the buffer is not direct.
+     */
+    public int read(ByteBuffer buffer) {
+        checkNotClosed();
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("The JSON can only be read into a direct ByteBuffer.");
+        }
+        if (!buffer.hasRemaining()) {
+            return 0;
+        }
+        int read = nativeRead(exporterPtr, buffer, buffer.position(), buffer.remaining());
+        if (read == 0) {
+            return -1;
+        }
+        buffer.position(buffer.position() + read);
+        return read;
+    }
+
+    /**
+     * Writes the JSON which has not been read yet to a file descriptor, e.g. from
+     * {@code ParcelFileDescriptor.getFd()}. The file descriptor is not closed.
+     */
+    public void writeTo(int fd) {
+        checkNotClosed();
+        nativeWriteToFd(exporterPtr, fd);
+    }
+
+    @Override
+    public void close() {
+        if (exporterPtr != 0) {
+            nativeDestroy(exporterPtr);
+            exporterPtr = 0;
+        }
+    }
+
+    private void checkNotClosed() {
+        if (exporterPtr == 0) {
+            throw new IllegalStateException("The JSON exporter has been closed.");
+        }
+    }
+
+    private static native long nativeCreate(long resultsPtr, @Nullable String[] properties, int linkDepth);
+    private static native void nativeDestroy(long exporterPtr);
+    private static native int nativeRead(long exporterPtr, ByteBuffer buffer, int offset, int size);
+    private static native void nativeWriteToFd(long exporterPtr, int fd);
+}
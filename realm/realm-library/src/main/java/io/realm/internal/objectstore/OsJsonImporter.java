@@ -0,0 +1,89 @@
+/*
+ * Copyright 2019 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.internal.objectstore;
+
+import java.io.InputStream;
+import java.nio.ByteBuffer;
+
+import io.realm.internal.Table;
+
+/**
+ * Creates objects from a JSON array of objects in native code, without building any Java objects for the elements.
+ * The text is parsed and written while it is read, so large inputs are imported with flat memory usage.
+ * <p>
+ * JSON properties are matched by the name of the properties in the Realm file, unknown properties are ignored.
+ * Properties which are not given keep their current value when an existing object is updated, and get their default
+ * value when a new object is created. Nested JSON objects are imported as linked objects. Dates are accepted as
+ * milliseconds since the epoch, as {@code "/Date(<milliseconds>)/"} or in ISO 8601 format, binaries as Base64 encoded
+ * strings.
+ * <p>
+ * All methods must be called inside a write transaction. They throw {@link IllegalArgumentException} if the JSON is
+ * malformed or a value doesn't match the type of its property. The objects imported before the error are not
+ * removed, cancel the transaction to discard them.
+ */
+public final class OsJsonImporter {
+
+    private OsJsonImporter() {
+    }
+
+    /**
+     * Imports the JSON read from a file descriptor, e.g. from {@code ParcelFileDescriptor.getFd()}. The file
+     * descriptor is not closed.
+     *
+     * @param updateExistingObjects if {@code true}, objects with an existing primary key are updated, otherwise they
+     * are always created.
+     * @return the number of objects created or updated.
+     */
+    public static long importFromFd(Table table, int fd, boolean updateExistingObjects) {
+        return nativeImportFromFd(table.getSharedRealm().getNativePtr(), table.getNativePtr(), fd,
+                updateExistingObjects);
+    }
+
+    /**
+     * Imports the JSON stored in a direct buffer, from its start up to its limit. The buffer is read in place.
+     *
+     * @param updateExistingObjects if {@code true}, objects with an existing primary key are updated, otherwise they
+     * are always created.
+     * @return the number of objects created or updated.
+     * @throws IllegalArgumentException if the buffer is not direct.
+     */
+    public static long importFromBuffer(Table table, ByteBuffer buffer, boolean updateExistingObjects) {
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException("The JSON must be stored in a direct ByteBuffer.");
+        }
+        return nativeImportFromBuffer(table.getSharedRealm().getNativePtr(), table.getNativePtr(), buffer,
+                buffer.limit(), updateExistingObjects);
+    }
+
+    /**
+     * Imports the JSON read from a stream, in chunks of 64KB. The stream is not closed.
+     *
+     * @param updateExistingObjects if {@code true}, objects with an existing primary key are updated, otherwise they
+     * are always created.
+     * @return the number of objects created or updated.
+     */
+    public static long importFromStream(Table table, InputStream in, boolean updateExistingObjects) {
+        return nativeImportFromStream(table.getSharedRealm().getNativePtr(), table.getNativePtr(), in,
+                updateExistingObjects);
+    }
+
+    private static native long nativeImportFromFd(long sharedRealmPtr, long tablePtr, int fd,
+                                                  boolean updateExistingObjects);
+    private static native long nativeImportFromBuffer(long sharedRealmPtr, long tablePtr, ByteBuffer buffer,
+                                                      long bufferSize, boolean updateExistingObjects);
+    private static native long nativeImportFromStream(long sharedRealmPtr, long tablePtr, InputStream in,
+                                                      boolean updateExistingObjects);
+}
@@ -16,6 +16,7 @@
 package io.realm.internal.objectstore;
 
 import java.io.Closeable;
+import java.nio.ByteBuffer;
 import java.util.Date;
 import java.util.List;
 import java.util.Set;
@@ -39,120 +40,118 @@ import io.realm.internal.UncheckedRow;
  * This class assumes it is only being used from within a write transaction. Using it outside one
  * will result in undefined behaviour.
  * <p>
- * The native
- * resources are created in the constructor of this class and destroyed when calling either of the
- * above two methods.
+ * The values are serialized into a direct {@link ByteBuffer} on the Java side (see {@link ObjectDataBuffer}) and the
+ * whole object is sent to native code in a single JNI call when calling either of the above two methods. The buffer
+ * is given back when the builder is closed, which happens automatically after calling them.
  * <p>
  * <H1>Design thoughts</H1>
  * <p>
- * Ideally we would have sent all properties across in one JNI call, but the only way to do that would
- * have been using two `Object[]` arrays which would have resulted in a ton of JNI calls back
+ * Sending all properties across as two `Object[]` arrays would have resulted in a ton of JNI calls back
  * again for resolving the primitive values of boxed types (since JNI do not know about boxed
- * primitives).
+ * primitives). Making a JNI call for each property avoids that, but the fixed cost of each call
+ * dominates for wide objects.
  * <p>
- * The upside of making a JNI call for each property is that we do minimal allocations on the Java
- * side. Also each method call is fairly lightweight as no checks are performed compared to using
- * Proxy setters and {@link io.realm.internal.UncheckedRow}. The only downside is the current need for
- * sending the key as well. Hopefully we can change that to schema indices at some point.
- * <p>
- * There is quite a few variants we can attempt to optimize this, but at this point we lack data
- * that can guide any architectural design and the only way to really find out is to build out each
- * solution and benchmark it.
+ * Writing the values into a direct buffer gives the best of both: there are no allocations on the Java
+ * side apart from growing the pooled buffer, and a single JNI call per object. The only downside is the current
+ * need for sending the key as well. Hopefully we can change that to schema indices at some point.
  */
 public class OsObjectBuilder implements Closeable {
 
     private final Table table;
     private final long sharedRealmPtr;
-    private final long builderPtr;
     private final long tablePtr;
+    private final long columnCount;
     private final NativeContext context;
+    private final ObjectDataBuffer data;
+    // Only created if the native builder is requested through getNativePtr().
+    private long builderPtr = 0;
 
     private static ItemCallback<? extends RealmModel> objectItemCallback = new ItemCallback<RealmModel>() {
         @Override
-        public void handleItem(long listPtr, RealmModel item) {
+        public void handleItem(ObjectDataBuffer data, RealmModel item) {
             RealmObjectProxy proxyItem = (RealmObjectProxy) item;
-            nativeAddIntegerListItem(listPtr, ((UncheckedRow) proxyItem.realmGet$proxyState().getRow$realm()).getNativePtr());
+            data.addObjectItem(((UncheckedRow) proxyItem.realmGet$proxyState().getRow$realm()).getNativePtr());
         }
     };
 
     private static ItemCallback<String> stringItemCallback = new ItemCallback<String>() {
         @Override
-        public void handleItem(long listPtr, String item) {
-            nativeAddStringListItem(listPtr, item);
+        public void handleItem(ObjectDataBuffer data, String item) {
+            data.addStringItem(item);
         }
     };
 
     private static ItemCallback<Byte> byteItemCallback = new ItemCallback<Byte>() {
         @Override
-        public void handleItem(long listPtr, Byte item) {
-            nativeAddIntegerListItem(listPtr, item.longValue());
+        public void handleItem(ObjectDataBuffer data, Byte item) {
+            data.addIntegerItem(item.longValue());
         }
     };
 
     private static ItemCallback<Short> shortItemCallback = new ItemCallback<Short>() {
         @Override
-        public void handleItem(long listPtr, Short item) {
-            nativeAddIntegerListItem(listPtr, item);
+        public void handleItem(ObjectDataBuffer data, Short item) {
+            data.addIntegerItem(item);
         }
     };
 
     private static ItemCallback<Integer> integerItemCallback = new ItemCallback<Integer>() {
         @Override
-        public void handleItem(long listPtr, Integer item) {
-            nativeAddIntegerListItem(listPtr, item);
+        public void handleItem(ObjectDataBuffer data, Integer item) {
+            data.addIntegerItem(item);
         }
     };
 
     private static ItemCallback<Long> longItemCallback = new ItemCallback<Long>() {
         @Override
-        public void handleItem(long listPtr, Long item) {
-            nativeAddIntegerListItem(listPtr, item);
+        public void handleItem(ObjectDataBuffer data, Long item) {
+            data.addIntegerItem(item);
         }
     };
 
     private static ItemCallback<Boolean> booleanItemCallback = new ItemCallback<Boolean>() {
         @Override
-        public void handleItem(long listPtr, Boolean item) {
-            nativeAddBooleanListItem(listPtr, item);
+        public void handleItem(ObjectDataBuffer data, Boolean item) {
+            data.addBooleanItem(item);
         }
     };
 
     private static ItemCallback<Float> floatItemCallback = new ItemCallback<Float>() {
         @Override
-        public void handleItem(long listPtr, Float item) {
-            nativeAddFloatListItem(listPtr, item);
+        public void handleItem(ObjectDataBuffer data, Float item) {
+            data.addFloatItem(item);
         }
     };
 
     private static ItemCallback<Double> doubleItemCallback = new ItemCallback<Double>() {
         @Override
-        public void handleItem(long listPtr, Double item) {
-            nativeAddDoubleListItem(listPtr, item);
+        public void handleItem(ObjectDataBuffer data, Double item) {
+            data.addDoubleItem(item);
         }
     };
 
     private static ItemCallback<Date> dateItemCallback = new ItemCallback<Date>() {
         @Override
-        public void handleItem(long listPtr, Date item) {
-            nativeAddDateListItem(listPtr, item.getTime());
+        public void handleItem(ObjectDataBuffer data, Date item) {
+            data.addDateItem(item.getTime());
         }
     };
 
     private static ItemCallback<byte[]> byteArrayItemCallback = new ItemCallback<byte[]>() {
         @Override
-        public void handleItem(long listPtr, byte[] item) {
-            nativeAddByteArrayListItem(listPtr, item);
+        public void handleItem(ObjectDataBuffer data, byte[] item) {
+            data.addByteArrayItem(item);
         }
     };
 
     private static ItemCallback<MutableRealmInteger> mutableRealmIntegerItemCallback = new ItemCallback<MutableRealmInteger>() {
         @Override
-        public void handleItem(long listPtr, MutableRealmInteger item) {
+        public void handleItem(ObjectDataBuffer data, MutableRealmInteger item) {
             Long value = item.get();
             if (value == null) {
-                nativeAddNullListItem(listPtr);
+                data.addNullItem();
             } else {
-                nativeAddIntegerListItem(listPtr, value);
+                data.addIntegerItem(value);
             }
         }
     };
@@ -165,196 +164,193 @@ public class OsObjectBuilder implements Closeable {
         this.sharedRealmPtr = sharedRealm.getNativePtr();
         this.table = table;
         this.tablePtr = table.getNativePtr();
-        this.builderPtr = nativeCreateBuilder(maxColumnIndex + 1);
+        this.columnCount = maxColumnIndex + 1;
+        this.data = new ObjectDataBuffer();
         this.context = sharedRealm.context;
         this.ignoreFieldsWithSameValue = flags.contains(ImportFlag.CHECK_SAME_VALUES_BEFORE_SET);
     }
 
     public void addInteger(long columnIndex, Byte val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddInteger(builderPtr, columnIndex, val);
+            data.addInteger(columnIndex, val);
         }
                                                     }
 
     public void addInteger(long columnIndex, Short val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddInteger(builderPtr, columnIndex, val);
+            data.addInteger(columnIndex, val);
         }
     }
 
     public void addInteger(long columnIndex, Integer val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddInteger(builderPtr, columnIndex, val);
+            data.addInteger(columnIndex, val);
         }
     }
 
     public void addInteger(long columnIndex, Long val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddInteger(builderPtr, columnIndex, val);
+            data.addInteger(columnIndex, val);
         }
     }
 
     public void addMutableRealmInteger(long columnIndex, MutableRealmInteger val) {
         if (val == null || val.get() == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddInteger(builderPtr, columnIndex, val.get());
+            data.addInteger(columnIndex, val.get());
         }
     }
 
     public void addString(long columnIndex, String val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddString(builderPtr, columnIndex, val);
+            data.addString(columnIndex, val);
         }
     }
 
     public void addFloat(long columnIndex, Float val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddFloat(builderPtr, columnIndex, val);
+            data.addFloat(columnIndex, val);
         }
     }
 
     public void addDouble(long columnIndex, Double val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddDouble(builderPtr, columnIndex, val);
+            data.addDouble(columnIndex, val);
         }
     }
 
     public void addBoolean(long columnIndex, Boolean val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddBoolean(builderPtr, columnIndex, val);
+            data.addBoolean(columnIndex, val);
         }
     }
 
     public void addDate(long columnIndex, Date val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddDate(builderPtr, columnIndex, val.getTime());
+            data.addDate(columnIndex, val.getTime());
         }
     }
 
     public void addByteArray(long columnIndex, byte[] val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
-            nativeAddByteArray(builderPtr, columnIndex, val);
+            data.addByteArray(columnIndex, val);
         }
     }
 
     public void addNull(long columnIndex) {
-        nativeAddNull(builderPtr, columnIndex);
+        data.addNull(columnIndex);
     }
 
     public void addObject(long columnIndex, RealmModel val) {
         if (val == null) {
-            nativeAddNull(builderPtr, columnIndex);
+            data.addNull(columnIndex);
         } else {
             RealmObjectProxy proxy = (RealmObjectProxy) val;
             UncheckedRow row = (UncheckedRow) proxy.realmGet$proxyState().getRow$realm();
-            nativeAddObject(builderPtr, columnIndex, row.getNativePtr());
+            data.addObject(columnIndex, row.getNativePtr());
         }
     }
 
-    private <T> void addListItem(long builderPtr, long columnIndex, List<T> list, ItemCallback<T> itemCallback) {
+    private <T> void addListItem(long columnIndex, List<T> list, ItemCallback<T> itemCallback) {
         if (list != null) {
-            long listPtr = nativeStartList(list.size());
+            data.startList(columnIndex, list.size());
             for (int i = 0; i < list.size(); i++) {
                 T item = list.get(i);
                 if (item == null) {
-                    nativeAddNullListItem(listPtr);
+                    data.addNullItem();
                 } else {
-                    itemCallback.handleItem(listPtr, item);
+                    itemCallback.handleItem(data, item);
                 }
             }
-            nativeStopList(builderPtr, columnIndex, listPtr);
         } else {
             addEmptyList(columnIndex);
         }
     }
 
     public <T extends RealmModel> void addObjectList(long columnIndex, RealmList<T> list) {
-        // Null objects references are not allowed. So we can optimize the JNI boundary by
-        // sending all object references in one long[] array.
+        // Null objects references are not allowed.
         if (list != null) {
-            long[] rowPointers = new long[list.size()];
+            data.startList(columnIndex, list.size());
             for (int i = 0; i < list.size(); i++) {
                 RealmObjectProxy item = (RealmObjectProxy) list.get(i);
                 if (item == null) {
                     throw new IllegalArgumentException("Null values are not allowed in RealmLists containing Realm models");
                 } else {
-                    rowPointers[i] = ((UncheckedRow) item.realmGet$proxyState().getRow$realm()).getNativePtr();
+                    data.addObjectItem(((UncheckedRow) item.realmGet$proxyState().getRow$realm()).getNativePtr());
                 }
             }
-            nativeAddObjectList(builderPtr, columnIndex, rowPointers);
         } else {
-            nativeAddObjectList(builderPtr, columnIndex, new long[0]);
+            addEmptyList(columnIndex);
         }
     }
 
     public void addStringList(long columnIndex, RealmList<String> list) {
-        addListItem(builderPtr, columnIndex, list, stringItemCallback);
+        addListItem(columnIndex, list, stringItemCallback);
     }
 
     public void addByteList(long columnIndex, RealmList<Byte> list) {
-        addListItem(builderPtr, columnIndex, list, byteItemCallback);
+        addListItem(columnIndex, list, byteItemCallback);
     }
 
     public void addShortList(long columnIndex, RealmList<Short> list) {
-        addListItem(builderPtr, columnIndex, list, shortItemCallback);
+        addListItem(columnIndex, list, shortItemCallback);
     }
 
     public void addIntegerList(long columnIndex, RealmList<Integer> list) {
-        addListItem(builderPtr, columnIndex, list, integerItemCallback);
+        addListItem(columnIndex, list, integerItemCallback);
     }
 
     public void addLongList(long columnIndex, RealmList<Long> list) {
-        addListItem(builderPtr, columnIndex, list, longItemCallback);
+        addListItem(columnIndex, list, longItemCallback);
     }
 
     public void addBooleanList(long columnIndex, RealmList<Boolean> list) {
-        addListItem(builderPtr, columnIndex, list, booleanItemCallback);
+        addListItem(columnIndex, list, booleanItemCallback);
     }
 
     public void addFloatList(long columnIndex, RealmList<Float> list) {
-        addListItem(builderPtr, columnIndex, list, floatItemCallback);
+        addListItem(columnIndex, list, floatItemCallback);
     }
 
     public void addDoubleList(long columnIndex, RealmList<Double> list) {
-        addListItem(builderPtr, columnIndex, list, doubleItemCallback);
+        addListItem(columnIndex, list, doubleItemCallback);
     }
 
     public void addDateList(long columnIndex, RealmList<Date> list) {
-        addListItem(builderPtr, columnIndex, list, dateItemCallback);
+        addListItem(columnIndex, list, dateItemCallback);
     }
 
     public void addByteArrayList(long columnIndex, RealmList<byte[]> list) {
-        addListItem(builderPtr, columnIndex, list, byteArrayItemCallback);
+        addListItem(columnIndex, list, byteArrayItemCallback);
     }
 
     public void addMutableRealmIntegerList(long columnIndex, RealmList<MutableRealmInteger> list) {
-        addListItem(builderPtr, columnIndex, list, mutableRealmIntegerItemCallback);
+        addListItem(columnIndex, list, mutableRealmIntegerItemCallback);
     }
 
     private void addEmptyList(long columnIndex) {
-        long listPtr = nativeStartList(0);
-        nativeStopList(builderPtr, columnIndex, listPtr);
+        data.startList(columnIndex, 0);
     }
 
     /**
@@ -364,7 +360,9 @@ public class OsObjectBuilder implements Closeable {
      */
     public void updateExistingObject() {
         try {
-            nativeCreateOrUpdate(sharedRealmPtr, tablePtr, builderPtr, true, ignoreFieldsWithSameValue);
+            data.endObject();
+            nativeCreateOrUpdateFromBuffer(sharedRealmPtr, tablePtr, columnCount, data.getBuffer(), data.size(),
+                    true, ignoreFieldsWithSameValue);
         } finally {
             close();
         }
@@ -378,7 +376,9 @@ public class OsObjectBuilder implements Closeable {
     public UncheckedRow createNewObject() {
         UncheckedRow row;
         try {
-            long rowPtr = nativeCreateOrUpdate(sharedRealmPtr, tablePtr, builderPtr, false, false);
+            data.endObject();
+            long rowPtr = nativeCreateOrUpdateFromBuffer(sharedRealmPtr, tablePtr, columnCount, data.getBuffer(),
+                    data.size(), false, false);
             row = new UncheckedRow(context, table, rowPtr);
         } finally {
             close();
@@ -387,9 +387,56 @@ public class OsObjectBuilder implements Closeable {
     }
 
     /**
-     * Returns the underlying native pointer representing this builder.
+     * Finishes the values of the current object and starts a new object of the same class. All objects added this way
+     * are created or updated by a single call to {@link #createOrUpdateObjects(boolean)}.
+     */
+    public void nextObject() {
+        data.endObject();
+    }
+
+    /**
+     * Creates or updates all objects added with {@link #nextObject()}, including the current one, in a single native
+     * call. The schema lookup and the object accessor context are only set up once for the whole batch.
+     *
+     * The builder is automatically closed after calling this method.
+     *
+     * @param updateExistingObjects if {@code true}, objects with an existing primary key are updated, otherwise they
+     * are always created.
+     * @return the row indices of the created or updated objects, in the order they were added.
+     */
+    public long[] createOrUpdateObjects(boolean updateExistingObjects) {
+        try {
+            data.endObject();
+            return nativeCreateOrUpdateBatchFromBuffer(sharedRealmPtr, tablePtr, columnCount, data.getBuffer(),
+                    data.size(), updateExistingObjects, updateExistingObjects && ignoreFieldsWithSameValue);
+        } finally {
+            close();
+        }
+    }
+
+    /**
+     * Finishes the current object and returns the buffer holding all objects added so far. Used by
+     * {@link OsImportPipeline}, which sends the buffer to native code itself. The buffer is released when the builder
+     * is closed.
+     */
+    ObjectDataBuffer finishObjects() {
+        data.endObject();
+        return data;
+    }
+
+    long getColumnCount() {
+        return columnCount;
+    }
+
+    /**
+     * Returns the native pointer to the object data added so far. The native data is only created the first time this
+     * is called, values added afterwards are not included.
      */
     public long getNativePtr() {
+        if (builderPtr == 0) {
+            data.endObject();
+            builderPtr = nativeCreateBuilderFromBuffer(columnCount, data.getBuffer(), data.size());
+        }
         return builderPtr;
     }
 
@@ -398,44 +445,31 @@ public class OsObjectBuilder implements Closeable {
      */
     @Override
     public void close() {
-        nativeDestroyBuilder(builderPtr);
+        if (builderPtr != 0) {
+            nativeDestroyBuilder(builderPtr);
+            builderPtr = 0;
+        }
+        data.release();
     }
 
     private interface ItemCallback<T>  {
-        void handleItem(long listPtr, T item);
+        void handleItem(ObjectDataBuffer data, T item);
     }
 
-    private static native long nativeCreateBuilder(long size);
+    private static native long nativeCreateBuilderFromBuffer(long columnCount, ByteBuffer buffer, long bufferSize);
     private static native void nativeDestroyBuilder(long builderPtr);
-    private static native long nativeCreateOrUpdate(long sharedRealmPtr,
-                                                    long tablePtr,
-                                                    long builderPtr,
-                                                    boolean updateExistingObject,
-                                                    boolean ignoreFieldsWithSameValue);
-
-    // Add simple properties
-    private static native void nativeAddNull(long builderPtr, long columnIndex);
-    private static native void nativeAddInteger(long builderPtr, long columnIndex, long val);
-    private static native void nativeAddString(long builderPtr, long columnIndex, String val);
-    private static native void nativeAddFloat(long builderPtr, long columnIndex, float val);
-    private static native void nativeAddDouble(long builderPtr, long columnIndex, double val);
-    private static native void nativeAddBoolean(long builderPtr, long columnIndex, boolean val);
-    private static native void nativeAddByteArray(long builderPtr, long columnIndex, byte[] val);
-    private static native void nativeAddDate(long builderPtr, long columnIndex, long val);
-    private static native void nativeAddObject(long builderPtr, long columnIndex, long rowPtr);
-
-    // Methods for adding lists
-    // Lists sent across JNI one element at a time
-    private static native long nativeStartList(long size);
-    private static native void nativeStopList(long builderPtr, long columnIndex, long listPtr);
-    private static native void nativeAddNullListItem(long listPtr);
-    private static native void nativeAddIntegerListItem(long listPtr, long value);
-    private static native void nativeAddStringListItem(long listPtr, String val);
-    private static native void nativeAddFloatListItem(long listPtr, float val);
-    private static native void nativeAddDoubleListItem(long listPtr, double val);
-    private static native void nativeAddBooleanListItem(long listPtr, boolean val);
-    private static native void nativeAddByteArrayListItem(long listPtr, byte[] val);
-    private static native void nativeAddDateListItem(long listPtr, long val);
-    private static native void nativeAddObjectListItem(long listPtr, long rowPtr);
-    private static native void nativeAddObjectList(long builderPtr, long columnIndex, long[] rowPtrs);
+    private static native long nativeCreateOrUpdateFromBuffer(long sharedRealmPtr,
+                                                              long tablePtr,
+                                                              long columnCount,
+                                                              ByteBuffer buffer,
+                                                              long bufferSize,
+                                                              boolean updateExistingObject,
+                                                              boolean ignoreFieldsWithSameValue);
+    private static native long[] nativeCreateOrUpdateBatchFromBuffer(long sharedRealmPtr,
+                                                                     long tablePtr,
+                                                                     long columnCount,
+                                                                     ByteBuffer buffer,
+                                                                     long bufferSize,
+                                                                     boolean updateExistingObjects,
+                                                                     boolean ignoreFieldsWithSameValue);
 }